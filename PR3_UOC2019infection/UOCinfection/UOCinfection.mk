@@ -3,6 +3,8 @@
 ## any manual changes will be erased      
 ##
 ## Debug
+## OpenMP runs the partitions of infectionTable_groupBy in parallel. It is used only if the compiler supports it, and it can be disabled with "make OpenMPSwitch="
+OpenMPSwitch           ?=$(shell echo "int main(void) { return 0; }" | gcc -fopenmp -x c - -o /dev/null 2>/dev/null && echo -fopenmp)
 ProjectName            :=UOCinfection
 ConfigurationName      :=Debug
 WorkspacePath          :=/home/uoc/Documents/codelite/workspaces/UOC2019infection
@@ -35,7 +37,7 @@ PreprocessOnlySwitch   :=-E
 ObjectsFileList        :="UOCinfection.txt"
 PCHCompileFlags        :=
 MakeDirCommand         :=mkdir -p
-LinkOptions            :=  
+LinkOptions            :=  $(OpenMPSwitch)
 IncludePath            :=  $(IncludeSwitch). $(IncludeSwitch). $(IncludeSwitch)./test/include $(IncludeSwitch)../UOCinfectiousAgent/include 
 IncludePCH             := 
 RcIncludePath          := 
@@ -50,8 +52,8 @@ LibPath                := $(LibraryPathSwitch). $(LibraryPathSwitch)../lib
 AR       := ar rcus
 CXX      := gcc
 CC       := gcc
-CXXFLAGS :=  -g -O0 -Wall $(Preprocessors)
-CFLAGS   :=  -g -O0 -Wall $(Preprocessors)
+CXXFLAGS :=  -g -O0 -Wall $(OpenMPSwitch) $(Preprocessors)
+CFLAGS   :=  -g -O0 -Wall $(OpenMPSwitch) $(Preprocessors)
 ASFLAGS  := 
 AS       := as
 
@@ -60,7 +62,7 @@ AS       := as
 ## User defined environment variables
 ##
 CodeLiteDir:=/usr/share/codelite
-Objects0=$(IntermediateDirectory)/test_src_test_suit.c$(ObjectSuffix) $(IntermediateDirectory)/test_src_utils.c$(ObjectSuffix) $(IntermediateDirectory)/test_src_test_pr2.c$(ObjectSuffix) $(IntermediateDirectory)/test_src_test_pr3.c$(ObjectSuffix) $(IntermediateDirectory)/test_src_test_pr1.c$(ObjectSuffix) $(IntermediateDirectory)/src_main.c$(ObjectSuffix) 
+Objects0=$(IntermediateDirectory)/test_src_test_suit.c$(ObjectSuffix) $(IntermediateDirectory)/test_src_utils.c$(ObjectSuffix) $(IntermediateDirectory)/test_src_test_pr2.c$(ObjectSuffix) $(IntermediateDirectory)/test_src_test_pr3.c$(ObjectSuffix) $(IntermediateDirectory)/test_src_test_pr1.c$(ObjectSuffix) $(IntermediateDirectory)/test_src_bench.c$(ObjectSuffix) $(IntermediateDirectory)/src_main.c$(ObjectSuffix) 
 
 
 
@@ -138,6 +140,14 @@ $(IntermediateDirectory)/test_src_test_pr1.c$(DependSuffix): test/src/test_pr1.c
 $(IntermediateDirectory)/test_src_test_pr1.c$(PreprocessSuffix): test/src/test_pr1.c
 	$(CC) $(CFLAGS) $(IncludePath) $(PreprocessOnlySwitch) $(OutputSwitch) $(IntermediateDirectory)/test_src_test_pr1.c$(PreprocessSuffix) test/src/test_pr1.c
 
+$(IntermediateDirectory)/test_src_bench.c$(ObjectSuffix): test/src/bench.c $(IntermediateDirectory)/test_src_bench.c$(DependSuffix)
+	$(CC) $(SourceSwitch) "/home/uoc/Documents/codelite/workspaces/UOC2019infection/UOCinfection/test/src/bench.c" $(CFLAGS) $(ObjectSwitch)$(IntermediateDirectory)/test_src_bench.c$(ObjectSuffix) $(IncludePath)
+$(IntermediateDirectory)/test_src_bench.c$(DependSuffix): test/src/bench.c
+	@$(CC) $(CFLAGS) $(IncludePath) -MG -MP -MT$(IntermediateDirectory)/test_src_bench.c$(ObjectSuffix) -MF$(IntermediateDirectory)/test_src_bench.c$(DependSuffix) -MM test/src/bench.c
+
+$(IntermediateDirectory)/test_src_bench.c$(PreprocessSuffix): test/src/bench.c
+	$(CC) $(CFLAGS) $(IncludePath) $(PreprocessOnlySwitch) $(OutputSwitch) $(IntermediateDirectory)/test_src_bench.c$(PreprocessSuffix) test/src/bench.c
+
 $(IntermediateDirectory)/src_main.c$(ObjectSuffix): src/main.c $(IntermediateDirectory)/src_main.c$(DependSuffix)
 	$(CC) $(SourceSwitch) "/home/uoc/Documents/codelite/workspaces/UOC2019infection/UOCinfection/src/main.c" $(CFLAGS) $(ObjectSwitch)$(IntermediateDirectory)/src_main.c$(ObjectSuffix) $(IncludePath)
 $(IntermediateDirectory)/src_main.c$(DependSuffix): src/main.c
@@ -3,6 +3,7 @@
 #include <string.h>
 #include <assert.h>
 #include "test_suit.h"
+#include "bench.h"
 
 void waitKey() {
     printf("Press enter to end...");
@@ -13,6 +14,7 @@ void help(const char* name) {
     printf("%s\t =>\t Run all tests and show results on screen\n", name);
     printf("%s -h\t =>\t Show this help\n", name);
     printf("%s -e [<file_path>]\t =>\t Run all tests and save results on file (default test_result.json)\n", name);
+    printf("%s -b [<agents>]\t =>\t Run the benchmarks (default %d agents)\n", name, BENCH_DEFAULT_AGENTS);
 }
 
 int main(int argc, char **argv)
@@ -45,6 +47,13 @@ int main(int argc, char **argv)
             assert(fout != NULL);
             testSuite_export(&test_suite, fout);
             fclose(fout);
+        } else if(strcmp(argv[1], "-b") == 0) {
+            // Run the benchmarks
+            if(argc > 2) {
+                run_benchmarks((unsigned int)atoi(argv[2]));
+            } else {
+                run_benchmarks(BENCH_DEFAULT_AGENTS);
+            }
         } else {
             // Invalid parameters
             printf("Invalid parameters\n");
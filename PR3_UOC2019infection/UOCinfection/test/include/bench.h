@@ -0,0 +1,11 @@
+#ifndef __BENCH_H__
+#define __BENCH_H__
+
+// Default number of infectious agents used by the benchmarks
+#define BENCH_DEFAULT_AGENTS 100000
+
+// Run the benchmarks and show the results on screen. They measure time and, with glibc, the heap used by each layout of the agents.
+// Cache misses are not measured by the benchmarks. The compact layout keeps the date inside the agent, so the scans by date of the compact agents only read the array for most of them.
+void run_benchmarks(unsigned int numAgents);
+
+#endif // __BENCH_H__
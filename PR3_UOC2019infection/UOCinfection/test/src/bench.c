@@ -0,0 +1,316 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <time.h>
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+#include <malloc.h>
+#define BENCH_HEAP_STATS
+#endif
+#include "bench.h"
+#include "reservoir.h"
+#include "infectiousAgent.h"
+
+// Number of times each scan is repeated, to get measurable times
+#define BENCH_SCAN_ROUNDS 20
+
+// Maximum number of agents removed from a table
+#define BENCH_REMOVE_COUNT 1000
+
+// Size of the blocks allocated between the fields of a scattered agent
+#define BENCH_NOISE_SIZE 48
+
+// Infectious agent with the old layout: one allocation for each field, and a private copy of the reservoir list
+typedef struct {
+    char* name;
+    float r0;
+    char* medium;
+    tDate* date;
+    char* city;
+    tReservoirTable* reservoirList;
+} tScatteredAgent;
+
+// Copy a string to a new block of memory
+static char* bench_strdup(const char* str) {
+    char* copy;
+
+    copy = (char*)malloc((strlen(str) + 1) * sizeof(char));
+    assert(copy != NULL);
+    strcpy(copy, str);
+
+    return copy;
+}
+
+// Keep some memory between the fields of an agent, as other structures would do in a real program
+static void* bench_noise(void** noise, unsigned int pos) {
+    noise[pos] = malloc(BENCH_NOISE_SIZE);
+    assert(noise[pos] != NULL);
+    return noise[pos];
+}
+
+// Name of the i-th agent of the benchmark
+static void bench_name(char* buffer, unsigned int i) {
+    sprintf(buffer, "AGENT_%08u", i);
+}
+
+// Bytes of the heap in use, measured by the allocator. It includes the overhead of each allocation. 0 if the allocator does not give this information
+static size_t bench_heapInUse(void) {
+#ifdef BENCH_HEAP_STATS
+    return mallinfo2().uordblks;
+#else
+    return 0;
+#endif
+}
+
+// Show the heap used by a layout, measured as the difference of the heap in use before and after creating its agents
+static void bench_showHeap(const char* layout, size_t before, size_t after, unsigned int numAgents) {
+#ifdef BENCH_HEAP_STATS
+    printf("  %s layout: %zu heap bytes (%.1f per agent)\n", layout, after - before, (double)(after - before) / numAgents);
+#else
+    printf("  %s layout: heap usage not available\n", layout);
+#endif
+}
+
+// Create the i-th agent with the old layout, as infectiousAgent_init did: each field and the copy of each reservoir are different blocks.
+// If noise is not NULL, other blocks of memory are allocated between the fields, as other structures would do in a real program
+static void bench_initScattered(tScatteredAgent* agent, unsigned int i, tReservoirTable* reservoirs, void** noise) {
+    char name[32];
+    unsigned int j;
+    tError err;
+
+    bench_name(name, i);
+    agent->name = bench_strdup(name);
+    if (noise != NULL) bench_noise(noise, 4 * i);
+    agent->r0 = 2.5f;
+    agent->medium = bench_strdup("AIRBORNE");
+    if (noise != NULL) bench_noise(noise, 4 * i + 1);
+    agent->date = (tDate*)malloc(sizeof(tDate));
+    assert(agent->date != NULL);
+    agent->date->day = 1;
+    agent->date->month = 1 + i % 12;
+    agent->date->year = 1900 + i % 120;
+    if (noise != NULL) bench_noise(noise, 4 * i + 2);
+    agent->city = bench_strdup("BARCELONA");
+    if (noise != NULL) bench_noise(noise, 4 * i + 3);
+    agent->reservoirList = (tReservoirTable*)malloc(sizeof(tReservoirTable));
+    assert(agent->reservoirList != NULL);
+    reservoirTable_init(agent->reservoirList);
+    for (j = 0; j < reservoirs->size; j++) {
+        err = reservoirTable_add(agent->reservoirList, &reservoirs->elements[j]);
+        assert(err == OK);
+    }
+}
+
+// Create the i-th agent with the compact layout
+static void bench_initCompact(tInfectiousAgent* agent, unsigned int i, tReservoirTable* reservoirs) {
+    char name[32];
+    tDate date;
+    tError err;
+
+    bench_name(name, i);
+    date.day = 1;
+    date.month = 1 + i % 12;
+    date.year = 1900 + i % 120;
+    err = infectiousAgent_init(agent, name, 2.5f, "AIRBORNE", &date, "BARCELONA", reservoirs);
+    assert(err == OK);
+}
+
+// Remove the memory of an agent with the old layout
+static void bench_freeScattered(tScatteredAgent* agent) {
+    free(agent->name);
+    free(agent->medium);
+    free(agent->date);
+    free(agent->city);
+    reservoirTable_free(agent->reservoirList);
+    free(agent->reservoirList);
+}
+
+// Elapsed time in milliseconds since start
+static double bench_elapsed(clock_t start) {
+    return 1000.0 * (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+// Scan the scattered agents, looking for the agents first found in a given year with a given name
+static unsigned int bench_scanScattered(tScatteredAgent* agents, unsigned int numAgents, int year, const char* name) {
+    unsigned int i, found = 0;
+
+    for (i = 0; i < numAgents; i++) {
+        if (agents[i].date->year == year && reservoirTable_size(agents[i].reservoirList) > 0 && strcmp(agents[i].name, name) == 0) {
+            found++;
+        }
+    }
+
+    return found;
+}
+
+// Scan the compact agents, looking for the agents first found in a given year with a given name
+static unsigned int bench_scanCompact(tInfectiousAgent* agents, unsigned int numAgents, int year, const char* name) {
+    unsigned int i, found = 0;
+
+    for (i = 0; i < numAgents; i++) {
+        if (agents[i].date.year == year && reservoirTable_size(agents[i].reservoirList) > 0 && strcmp(agents[i].name, name) == 0) {
+            found++;
+        }
+    }
+
+    return found;
+}
+
+// Register the agents in a table, one by one and at once
+static void bench_agentTable(tInfectiousAgent* agents, unsigned int numAgents) {
+    tInfectiousAgentTable table;
+    clock_t start;
+    const char* modeNames[] = { "shift", "swap", "tombstone" };
+    tRemoveMode mode;
+    unsigned int i, found = 0;
+    tError err;
+
+    printf("Infectious agents table benchmark (%u agents)\n", numAgents);
+
+    // Each add checks that the name is not in the table
+    infectiousAgentTable_init(&table);
+    start = clock();
+    for (i = 0; i < numAgents; i++) {
+        err = infectiousAgentTable_add(&table, &agents[i]);
+        assert(err == OK);
+    }
+    printf("  add: %.2f ms\n", bench_elapsed(start));
+
+    start = clock();
+    for (i = 0; i < numAgents; i++) {
+        if (infectiousAgentTable_find(&table, agents[i].name) != NULL) {
+            found++;
+        }
+    }
+    printf("  find all: %.2f ms\n", bench_elapsed(start));
+    assert(found == numAgents);
+    infectiousAgentTable_free(&table);
+
+    infectiousAgentTable_init(&table);
+    start = clock();
+    err = infectiousAgentTable_addBulk(&table, agents, numAgents);
+    assert(err == OK);
+    printf("  addBulk: %.2f ms\n", bench_elapsed(start));
+    infectiousAgentTable_free(&table);
+
+    // Remove some of the agents, starting from the first ones, in each remove mode
+    for (mode = REMOVE_SHIFT; mode <= REMOVE_TOMBSTONE; mode++) {
+        infectiousAgentTable_init(&table);
+        err = infectiousAgentTable_addBulk(&table, agents, numAgents);
+        assert(err == OK);
+        infectiousAgentTable_setRemoveMode(&table, mode);
+        start = clock();
+        for (i = 0; i < numAgents / 2 && i < BENCH_REMOVE_COUNT; i++) {
+            err = infectiousAgentTable_remove(&table, &agents[i * 2]);
+            assert(err == OK);
+        }
+        printf("  remove %u (%s): %.2f ms\n", i, modeNames[mode], bench_elapsed(start));
+        infectiousAgentTable_free(&table);
+    }
+}
+
+// Run the benchmarks and show the results on screen.
+void run_benchmarks(unsigned int numAgents) {
+    tScatteredAgent* scattered;
+    tInfectiousAgent* compact;
+    tReservoirTable reservoirs;
+    tReservoir bat, pangolin;
+    void** noise;
+    char name[32];
+    size_t before, after;
+    unsigned int i, round, found = 0;
+    double scatteredTime, compactTime;
+    clock_t start;
+    tError err;
+
+    assert(numAgents > 0);
+
+    printf("Infectious agents layout benchmark (%u agents)\n", numAgents);
+
+    // Both layouts have the same fields, with the same list of reservoirs
+    reservoirTable_init(&reservoirs);
+    err = reservoir_init(&bat, "Bat", "Chiroptera");
+    assert(err == OK);
+    err = reservoirTable_add(&reservoirs, &bat);
+    assert(err == OK);
+    err = reservoir_init(&pangolin, "Pangolin", "Manis pentadactyla");
+    assert(err == OK);
+    err = reservoirTable_add(&reservoirs, &pangolin);
+    assert(err == OK);
+
+    scattered = (tScatteredAgent*)malloc(numAgents * sizeof(tScatteredAgent));
+    compact = (tInfectiousAgent*)malloc(numAgents * sizeof(tInfectiousAgent));
+    noise = (void**)malloc(4 * numAgents * sizeof(void*));
+    assert(scattered != NULL && compact != NULL && noise != NULL);
+
+    // Measure the heap used by each layout. Nothing else is allocated meanwhile, so the difference is the memory of the agents
+    before = bench_heapInUse();
+    for (i = 0; i < numAgents; i++) {
+        bench_initScattered(&scattered[i], i, &reservoirs, NULL);
+    }
+    after = bench_heapInUse();
+    bench_showHeap("scattered", before, after, numAgents);
+    for (i = 0; i < numAgents; i++) {
+        bench_freeScattered(&scattered[i]);
+    }
+
+    before = bench_heapInUse();
+    for (i = 0; i < numAgents; i++) {
+        bench_initCompact(&compact[i], i, &reservoirs);
+    }
+    after = bench_heapInUse();
+    bench_showHeap("compact", before, after, numAgents);
+    for (i = 0; i < numAgents; i++) {
+        infectiousAgent_free(&compact[i]);
+    }
+
+    // Create the scattered agents for the scans. Each field is a different block, separated by other blocks of memory.
+    start = clock();
+    for (i = 0; i < numAgents; i++) {
+        bench_initScattered(&scattered[i], i, &reservoirs, noise);
+    }
+    scatteredTime = bench_elapsed(start);
+
+    // Create the compact agents. The noise blocks are still there, so both layouts live in the same heap.
+    start = clock();
+    for (i = 0; i < numAgents; i++) {
+        bench_initCompact(&compact[i], i, &reservoirs);
+    }
+    compactTime = bench_elapsed(start);
+    printf("  create: scattered %.2f ms, compact %.2f ms\n", scatteredTime, compactTime);
+
+    // Scan the agents looking at the date, the reservoirs and the name of each one. The name is only read when the date matches, so the scattered agents follow a pointer for each date and the compact agents do not.
+    start = clock();
+    for (round = 0; round < BENCH_SCAN_ROUNDS; round++) {
+        bench_name(name, (round * 7919) % numAgents);
+        found += bench_scanScattered(scattered, numAgents, 1900 + ((round * 7919) % numAgents) % 120, name);
+    }
+    scatteredTime = bench_elapsed(start);
+
+    start = clock();
+    for (round = 0; round < BENCH_SCAN_ROUNDS; round++) {
+        bench_name(name, (round * 7919) % numAgents);
+        found += bench_scanCompact(compact, numAgents, 1900 + ((round * 7919) % numAgents) % 120, name);
+    }
+    compactTime = bench_elapsed(start);
+
+    assert(found == 2 * BENCH_SCAN_ROUNDS);
+    printf("  scan x%d: scattered %.2f ms, compact %.2f ms\n", BENCH_SCAN_ROUNDS, scatteredTime, compactTime);
+
+    bench_agentTable(compact, numAgents);
+
+    // Remove all the memory
+    for (i = 0; i < numAgents; i++) {
+        bench_freeScattered(&scattered[i]);
+        infectiousAgent_free(&compact[i]);
+    }
+    for (i = 0; i < 4 * numAgents; i++) {
+        free(noise[i]);
+    }
+    free(noise);
+    free(compact);
+    free(scattered);
+    reservoir_free(&bat);
+    reservoir_free(&pangolin);
+    reservoirTable_free(&reservoirs);
+}
@@ -1,10 +1,14 @@
 #include <assert.h>
 #include <string.h>
+#include <stdio.h>
 #include "test_pr1.h"
 #include "reservoir.h"
 #include "infectiousAgent.h"
 #include "infection.h"
 #include "country.h"
+#include "groupBy.h"
+#include "registry.h"
+#include "stringPool.h"
 
 // Run all tests for PR1
 bool run_pr1(tTestSuite* test_suite) {
@@ -31,7 +35,11 @@ bool run_pr1_ex1(tTestSection* test_section) {
 
     bool passed = true, failed = false;
     tReservoir *reservoirAux, rat, bat, monkey, blackRat;
-    tReservoirTable reservoirsTable;
+    tReservoir bulk[4], reservoirBig;
+    tReservoirTable reservoirsTable, bigTable1, bigTable2;
+    char name[32];
+    char* nameAux;
+    int i;
     tError err;
 
     // TEST 1: Initialize the table of reservoirs
@@ -214,6 +222,135 @@ bool run_pr1_ex1(tTestSection* test_section) {
         end_test(test_section, "PR1_EX1_6", true);
     }
 
+    // TEST 7: Add reservoirs in bulk
+    failed = false;
+    start_test(test_section, "PR1_EX1_7", "Add reservoirs in bulk");
+
+    bulk[0] = rat;
+    bulk[1] = bat;
+    bulk[2] = blackRat;
+    bulk[3] = monkey;
+
+    err = reservoirTable_reserve(&reservoirsTable, 2);
+    if (err != OK) {
+        failed = true;
+    }
+    err = reservoirTable_add(&reservoirsTable, &bat);
+    if (err != OK) {
+        failed = true;
+    }
+    err = reservoirTable_addBulk(&reservoirsTable, bulk, 4);
+    if (err != OK) {
+        failed = true;
+    }
+    if (reservoirTable_size(&reservoirsTable) != 3) {
+        failed = true;
+    }
+    if (reservoirTable_find(&reservoirsTable, "rat") == NULL ||
+        reservoirTable_find(&reservoirsTable, "bat") == NULL ||
+        reservoirTable_find(&reservoirsTable, "monkey") == NULL) {
+        failed = true;
+    }
+
+    if (failed) {
+        end_test(test_section, "PR1_EX1_7", false);
+        passed = false;
+    }
+    else {
+        end_test(test_section, "PR1_EX1_7", true);
+    }
+
+    // TEST 8: Find and compare big tables of reservoirs
+    failed = false;
+    start_test(test_section, "PR1_EX1_8", "Find and compare big tables of reservoirs");
+
+    reservoirTable_init(&bigTable1);
+    reservoirTable_init(&bigTable2);
+    for (i = 0; i < 50; i++) {
+        sprintf(name, "reservoir %d", i);
+        reservoir_init(&reservoirBig, name, "Rattus rattus");
+        reservoirTable_add(&bigTable1, &reservoirBig);
+        reservoir_free(&reservoirBig);
+
+        // The second table has the same reservoirs in reverse order
+        sprintf(name, "reservoir %d", 49 - i);
+        reservoir_init(&reservoirBig, name, "Rattus rattus");
+        reservoirTable_add(&bigTable2, &reservoirBig);
+        reservoir_free(&reservoirBig);
+    }
+
+    if (reservoirTable_size(&bigTable1) != 50 || !reservoirTable_equals(&bigTable1, &bigTable2)) {
+        failed = true;
+    }
+    reservoirAux = reservoirTable_find(&bigTable1, "reservoir 37");
+    if (reservoirAux == NULL || strcmp(reservoirAux->name, "reservoir 37") != 0) {
+        failed = true;
+    }
+    if (reservoirTable_find(&bigTable1, "reservoir 50") != NULL) {
+        failed = true;
+    }
+
+    reservoir_init(&reservoirBig, "reservoir 10", "Rattus rattus");
+    err = reservoirTable_remove(&bigTable2, &reservoirBig);
+    if (err != OK || reservoirTable_find(&bigTable2, "reservoir 10") != NULL || reservoirTable_find(&bigTable2, "reservoir 11") == NULL) {
+        failed = true;
+    }
+    reservoir_free(&reservoirBig);
+
+    reservoir_init(&reservoirBig, "reservoir 50", "Rattus rattus");
+    reservoirTable_add(&bigTable2, &reservoirBig);
+    reservoir_free(&reservoirBig);
+    if (reservoirTable_equals(&bigTable1, &bigTable2) || reservoirTable_equals(&bigTable2, &bigTable1)) {
+        failed = true;
+    }
+
+    reservoirTable_free(&bigTable1);
+    reservoirTable_free(&bigTable2);
+
+    if (failed) {
+        end_test(test_section, "PR1_EX1_8", false);
+        passed = false;
+    }
+    else {
+        end_test(test_section, "PR1_EX1_8", true);
+    }
+
+    // TEST 9: Remove reservoirs moving the elements
+    failed = false;
+    start_test(test_section, "PR1_EX1_9", "Remove reservoirs moving the elements");
+
+    reservoirTable_free(&reservoirsTable);
+    reservoirTable_addBulk(&reservoirsTable, bulk, 4);
+
+    // The last reservoir fills the gap, keeping its strings
+    nameAux = reservoirsTable.elements[2].name;
+    reservoirTable_setRemoveMode(&reservoirsTable, REMOVE_SWAP);
+    err = reservoirTable_remove(&reservoirsTable, &rat);
+    if (err != OK || reservoirTable_size(&reservoirsTable) != 2 || reservoirsTable.elements[0].name != nameAux) {
+        failed = true;
+    }
+
+    reservoirTable_add(&reservoirsTable, &rat);
+    bulk[0] = bat;
+    bulk[1] = rat;
+    err = reservoirTable_removeMany(&reservoirsTable, bulk, 2);
+    if (err != OK || reservoirTable_size(&reservoirsTable) != 1 || reservoirTable_find(&reservoirsTable, "monkey") == NULL) {
+        failed = true;
+    }
+
+    err = reservoirTable_removeMany(&reservoirsTable, bulk, 2);
+    if (err != ERR_NOT_FOUND || reservoirTable_size(&reservoirsTable) != 1) {
+        failed = true;
+    }
+
+    if (failed) {
+        end_test(test_section, "PR1_EX1_9", false);
+        passed = false;
+    }
+    else {
+        end_test(test_section, "PR1_EX1_9", true);
+    }
+
 
     // Remove used memory
     reservoirTable_free(&reservoirsTable);
@@ -230,8 +367,9 @@ bool run_pr1_ex1(tTestSection* test_section) {
 // Run tests for PR1 exercise 2
 bool run_pr1_ex2(tTestSection* test_section) {
     bool passed = true, failed = false;
-    tInfectiousAgent influenzaA1, influenzaB, infectiousAgent_copy;
-    tDate date1, date2;
+    tInfectiousAgent influenzaA1, influenzaA2, influenzaB;
+    tInfectiousAgent infectiousAgent_copy = { NULL, 0, NULL, { 0, 0, 0 }, NULL, NULL };
+    tDate date1, date2, date_aux;
     tReservoirTable reservoirListA1, reservoirListB, *reservoirList_aux;
     tReservoir rat, bat, monkey;
     tError err;
@@ -310,6 +448,112 @@ bool run_pr1_ex2(tTestSection* test_section) {
         end_test(test_section, "PR1_EX2_3", true);
     }
 
+    // TEST 4: Share the reservoirs list
+    failed = false;
+    start_test(test_section, "PR1_EX2_4", "Share the reservoirs list");
+
+    // A copy uses the same list
+    if (infectiousAgent_getReservoirs(&infectiousAgent_copy) != infectiousAgent_getReservoirs(&influenzaA1)) {
+        failed = true;
+    }
+
+    // It gets its own list before changing it
+    reservoirList_aux = infectiousAgent_getMutableReservoirs(&infectiousAgent_copy);
+    if (reservoirList_aux == NULL || reservoirList_aux == infectiousAgent_getReservoirs(&influenzaA1)) {
+        failed = true;
+    }
+    else {
+        reservoirTable_add(reservoirList_aux, &monkey);
+        if (reservoirTable_size(infectiousAgent_getReservoirs(&infectiousAgent_copy)) != 3 ||
+            reservoirTable_size(infectiousAgent_getReservoirs(&influenzaA1)) != 2) {
+            failed = true;
+        }
+    }
+
+    // The list of the user is copied only once: other agents initialized with it share the same copy
+    infectiousAgent_init(&influenzaA2, "Influenza H1N2", 0.2, "Air", &date1, "New York", &reservoirListA1);
+    if (infectiousAgent_getReservoirs(&influenzaA2) != infectiousAgent_getReservoirs(&influenzaA1)) {
+        failed = true;
+    }
+    infectiousAgent_free(&influenzaA2);
+
+    // After the list of the user changes, the next agents get a new copy and the previous ones keep their list
+    reservoirTable_add(&reservoirListA1, &monkey);
+    infectiousAgent_init(&influenzaA2, "Influenza H1N2", 0.2, "Air", &date1, "New York", &reservoirListA1);
+    if (infectiousAgent_getReservoirs(&influenzaA2) == infectiousAgent_getReservoirs(&influenzaA1) ||
+        reservoirTable_size(infectiousAgent_getReservoirs(&influenzaA2)) != 3 ||
+        reservoirTable_size(infectiousAgent_getReservoirs(&influenzaA1)) != 2) {
+        failed = true;
+    }
+    infectiousAgent_free(&influenzaA2);
+    reservoirTable_remove(&reservoirListA1, &monkey);
+
+    if (failed) {
+        end_test(test_section, "PR1_EX2_4", false);
+        passed = false;
+    }
+    else {
+        end_test(test_section, "PR1_EX2_4", true);
+    }
+
+    // TEST 5: Access the fields of a infectious agent
+    failed = false;
+    start_test(test_section, "PR1_EX2_5", "Access the fields of a infectious agent");
+
+    if (strcmp(infectiousAgent_getName(&influenzaB), "Influenza Yamagata") != 0 ||
+        strcmp(infectiousAgent_getMedium(&influenzaB), "Air") != 0 ||
+        strcmp(infectiousAgent_getCity(&influenzaB), "London") != 0 ||
+        infectiousAgent_getR0(&influenzaB) != 0.15f) {
+        failed = true;
+    }
+    date_aux = infectiousAgent_getDate(&influenzaB);
+    if (date_aux.day != 22 || date_aux.month != 10 || date_aux.year != 2019) {
+        failed = true;
+    }
+
+    // The strings are stored in a single block, starting with the name
+    if (influenzaB.medium != influenzaB.name + strlen(influenzaB.name) + 1 ||
+        influenzaB.city != influenzaB.medium + strlen(influenzaB.medium) + 1) {
+        failed = true;
+    }
+
+    if (failed) {
+        end_test(test_section, "PR1_EX2_5", false);
+        passed = false;
+    }
+    else {
+        end_test(test_section, "PR1_EX2_5", true);
+    }
+
+    // TEST 6: Copy a infectious agent to an initialized infectious agent
+    failed = false;
+    start_test(test_section, "PR1_EX2_6", "Copy a infectious agent to an initialized infectious agent");
+
+    // The previous data of the copy is freed, so its reservoir list is not used by it anymore
+    reservoirList_aux = infectiousAgent_getReservoirs(&infectiousAgent_copy);
+    err = infectiousAgent_cpy(&infectiousAgent_copy, &influenzaB);
+    if (err != OK || !infectiousAgent_equals(&infectiousAgent_copy, &influenzaB)) {
+        failed = true;
+    }
+    if (infectiousAgent_getReservoirs(&infectiousAgent_copy) == reservoirList_aux ||
+        infectiousAgent_getReservoirs(&infectiousAgent_copy) != infectiousAgent_getReservoirs(&influenzaB)) {
+        failed = true;
+    }
+
+    // Copying an agent to itself keeps its data
+    err = infectiousAgent_cpy(&influenzaB, &influenzaB);
+    if (err != OK || strcmp(infectiousAgent_getName(&influenzaB), "Influenza Yamagata") != 0) {
+        failed = true;
+    }
+
+    if (failed) {
+        end_test(test_section, "PR1_EX2_6", false);
+        passed = false;
+    }
+    else {
+        end_test(test_section, "PR1_EX2_6", true);
+    }
+
     // Remove used memory
 
     infectiousAgent_free(&infectiousAgent_copy);
@@ -333,7 +577,13 @@ bool run_pr1_ex3(tTestSection* test_section) {
     tDate date1, date2, date3;
     tReservoirTable reservoirListA1, reservoirListA2, reservoirListB;
     tReservoir rat, bat, monkey;
-    tInfectiousAgentTable infectiousAgentTable;
+    tInfectiousAgentTable infectiousAgentTable, variantsTable;
+    tInfectiousAgent variants[200], *agentsAux[200];
+    tSpeciesEntry* speciesAux;
+    tReservoirTable* reservoirList_aux;
+    unsigned int poolSize;
+    char name[32];
+    int i;
     tError err;
 
     // PRE TEST: Create reservoirs elements
@@ -519,7 +769,259 @@ bool run_pr1_ex3(tTestSection* test_section) {
         end_test(test_section, "PR1_EX3_5", true);
     }
 
+    // TEST 6: Find infectious agents by species
+    failed = false;
+    start_test(test_section, "PR1_EX3_6", "Find infectious agents by species");
+
+    // Equal strings are shared
+    if (reservoirListA1.elements[0].species != reservoirListB.elements[0].species) {
+        failed = true;
+    }
+
+    speciesAux = infectiousAgentTable_findBySpecies(&infectiousAgentTable, "Rattus rattus");
+    if (speciesAux == NULL || speciesAux->size != 2) {
+        failed = true;
+    }
+    speciesAux = infectiousAgentTable_findBySpecies(&infectiousAgentTable, "Macaca mulatta");
+    if (speciesAux == NULL || speciesAux->size != 1) {
+        failed = true;
+    }
+    else if (strcmp(speciesAux->refs[0].agent, "Influenza H3N2") != 0 || strcmp(speciesAux->refs[0].reservoir, "monkey") != 0) {
+        failed = true;
+    }
+    if (infectiousAgentTable_findBySpecies(&infectiousAgentTable, "Homo sapiens") != NULL) {
+        failed = true;
+    }
+
+    infectiousAgentTable_remove(&infectiousAgentTable, &influenzaA2);
+    if (infectiousAgentTable_findBySpecies(&infectiousAgentTable, "Macaca mulatta") != NULL) {
+        failed = true;
+    }
+    speciesAux = infectiousAgentTable_findBySpecies(&infectiousAgentTable, "Rattus rattus");
+    if (speciesAux == NULL || speciesAux->size != 1 || strcmp(speciesAux->refs[0].agent, "Influenza H1N1") != 0) {
+        failed = true;
+    }
+
+    // Change the reservoirs of an agent of the table. The index keeps the reservoirs it had when it was added, until it is updated
+    infectiousAgentTable_add(&infectiousAgentTable, &influenzaA2);
+    infectiousAgent_aux = infectiousAgentTable_find(&infectiousAgentTable, "Influenza H1N1");
+    reservoirList_aux = infectiousAgent_getMutableReservoirs(infectiousAgent_aux);
+    reservoirTable_remove(reservoirList_aux, &rat);
+    reservoirTable_add(reservoirList_aux, &monkey);
+    speciesAux = infectiousAgentTable_findBySpecies(&infectiousAgentTable, "Rattus rattus");
+    if (speciesAux == NULL || speciesAux->size != 2) {
+        failed = true;
+    }
+    if (infectiousAgentTable_updateSpecies(&infectiousAgentTable, "Influenza H1N1") != OK) {
+        failed = true;
+    }
+    speciesAux = infectiousAgentTable_findBySpecies(&infectiousAgentTable, "Rattus rattus");
+    if (speciesAux == NULL || speciesAux->size != 1 || strcmp(speciesAux->refs[0].agent, "Influenza H3N2") != 0) {
+        failed = true;
+    }
+    speciesAux = infectiousAgentTable_findBySpecies(&infectiousAgentTable, "Macaca mulatta");
+    if (speciesAux == NULL || speciesAux->size != 2) {
+        failed = true;
+    }
+    if (infectiousAgentTable_updateSpecies(&infectiousAgentTable, "Influenza B") != ERR_NOT_FOUND) {
+        failed = true;
+    }
+
+    // Removing an agent whose reservoirs changed after they were indexed leaves no references to it
+    reservoirList_aux = infectiousAgent_getMutableReservoirs(infectiousAgent_aux);
+    reservoirTable_remove(reservoirList_aux, &bat);
+    poolSize = stringPool_size();
+    infectiousAgentTable_remove(&infectiousAgentTable, infectiousAgent_aux);
+    speciesAux = infectiousAgentTable_findBySpecies(&infectiousAgentTable, "Rhinolophus FerrumEquinum");
+    if (speciesAux == NULL || speciesAux->size != 1 || strcmp(speciesAux->refs[0].agent, "Influenza H3N2") != 0) {
+        failed = true;
+    }
+    speciesAux = infectiousAgentTable_findBySpecies(&infectiousAgentTable, "Macaca mulatta");
+    if (speciesAux == NULL || speciesAux->size != 1 || strcmp(speciesAux->refs[0].agent, "Influenza H3N2") != 0) {
+        failed = true;
+    }
+    // The name of the removed agent is not used anymore
+    if (stringPool_size() != poolSize - 1) {
+        failed = true;
+    }
+
+    if (failed) {
+        end_test(test_section, "PR1_EX3_6", false);
+        passed = false;
+    }
+    else {
+        end_test(test_section, "PR1_EX3_6", true);
+    }
+
+    // TEST 7: Add many infectious agents at once
+    failed = false;
+    start_test(test_section, "PR1_EX3_7", "Add many infectious agents at once");
+
+    for (i = 0; i < 200; i++) {
+        sprintf(name, "Influenza variant %d", i % 150);
+        infectiousAgent_init(&variants[i], name, 0.1 + i / 1000.0, "Air", &date1, "New York", &reservoirListA1);
+    }
+
+    infectiousAgentTable_init(&variantsTable);
+    infectiousAgentTable_add(&variantsTable, &influenzaB);
+    // The last 50 variants are repeated
+    err = infectiousAgentTable_addBulk(&variantsTable, variants, 200);
+    if (err != OK || infectiousAgentTable_size(&variantsTable) != 151) {
+        failed = true;
+    }
+    if (infectiousAgentTable_add(&variantsTable, &variants[10]) != ERR_DUPLICATED) {
+        failed = true;
+    }
+
+    for (i = 0; i < 150 && !failed; i++) {
+        infectiousAgent_aux = infectiousAgentTable_find(&variantsTable, variants[i].name);
+        if (infectiousAgent_aux == NULL || !infectiousAgent_equals(infectiousAgent_aux, &variants[i])) {
+            failed = true;
+        }
+    }
+
+    // The index is still valid after removing an agent
+    infectiousAgentTable_remove(&variantsTable, &variants[20]);
+    if (infectiousAgentTable_find(&variantsTable, variants[20].name) != NULL ||
+        infectiousAgentTable_find(&variantsTable, "Influenza Yamagata") == NULL) {
+        failed = true;
+    }
+    infectiousAgent_aux = infectiousAgentTable_find(&variantsTable, variants[149].name);
+    if (infectiousAgent_aux == NULL || !infectiousAgent_equals(infectiousAgent_aux, &variants[149])) {
+        failed = true;
+    }
+
+    if (failed) {
+        end_test(test_section, "PR1_EX3_7", false);
+        passed = false;
+    }
+    else {
+        end_test(test_section, "PR1_EX3_7", true);
+    }
+
+    // TEST 8: Remove infectious agents in all the remove modes
+    failed = false;
+    start_test(test_section, "PR1_EX3_8", "Remove infectious agents in all the remove modes");
+
+    infectiousAgentTable_free(&variantsTable);
+    infectiousAgentTable_init(&variantsTable);
+    infectiousAgentTable_addBulk(&variantsTable, variants, 10);
+
+    // The following agents are moved one position
+    infectiousAgentTable_remove(&variantsTable, &variants[0]);
+    if (infectiousAgentTable_size(&variantsTable) != 9 || strcmp(variantsTable.elements[0].name, variants[1].name) != 0) {
+        failed = true;
+    }
+
+    // The index of names still finds the moved agents, and a new agent reuses the id of the removed one
+    for (i = 1; i < 10; i++) {
+        infectiousAgent_aux = infectiousAgentTable_find(&variantsTable, variants[i].name);
+        if (infectiousAgent_aux == NULL || !infectiousAgent_equals(infectiousAgent_aux, &variants[i])) {
+            failed = true;
+        }
+    }
+    if (infectiousAgentTable_add(&variantsTable, &variants[0]) != OK || variantsTable.idCount != 10 ||
+        infectiousAgentTable_find(&variantsTable, variants[0].name) != &variantsTable.elements[9] ||
+        infectiousAgentTable_remove(&variantsTable, &variants[0]) != OK) {
+        failed = true;
+    }
+
+    // The last agent is moved to the gap
+    infectiousAgentTable_setRemoveMode(&variantsTable, REMOVE_SWAP);
+    infectiousAgentTable_remove(&variantsTable, &variants[1]);
+    if (infectiousAgentTable_size(&variantsTable) != 8 || strcmp(variantsTable.elements[0].name, variants[9].name) != 0) {
+        failed = true;
+    }
+
+    // The agents are marked as removed, and the others are not moved
+    infectiousAgentTable_setRemoveMode(&variantsTable, REMOVE_TOMBSTONE);
+    infectiousAgent_aux = infectiousAgentTable_find(&variantsTable, variants[5].name);
+    infectiousAgentTable_remove(&variantsTable, &variants[2]);
+    infectiousAgentTable_remove(&variantsTable, &variants[3]);
+    if (infectiousAgentTable_size(&variantsTable) != 6 || infectiousAgentTable_find(&variantsTable, variants[5].name) != infectiousAgent_aux ||
+        infectiousAgentTable_find(&variantsTable, variants[2].name) != NULL) {
+        failed = true;
+    }
+    if (infectiousAgentTable_remove(&variantsTable, &variants[2]) != ERR_NOT_FOUND) {
+        failed = true;
+    }
+
+    // When most of the table are removed agents, it is compacted
+    infectiousAgentTable_remove(&variantsTable, &variants[4]);
+    infectiousAgentTable_remove(&variantsTable, &variants[5]);
+    infectiousAgentTable_remove(&variantsTable, &variants[6]);
+    if (infectiousAgentTable_size(&variantsTable) != 3 || variantsTable.size != 3 ||
+        strcmp(variantsTable.elements[0].name, variants[9].name) != 0 || strcmp(variantsTable.elements[1].name, variants[7].name) != 0) {
+        failed = true;
+    }
+    for (i = 7; i < 10; i++) {
+        infectiousAgent_aux = infectiousAgentTable_find(&variantsTable, variants[i].name);
+        if (infectiousAgent_aux == NULL || !infectiousAgent_equals(infectiousAgent_aux, &variants[i])) {
+            failed = true;
+        }
+    }
+
+    if (failed) {
+        end_test(test_section, "PR1_EX3_8", false);
+        passed = false;
+    }
+    else {
+        end_test(test_section, "PR1_EX3_8", true);
+    }
+
+    // TEST 9: Find infectious agents by R0
+    failed = false;
+    start_test(test_section, "PR1_EX3_9", "Find infectious agents by R0");
+
+    infectiousAgentTable_free(&variantsTable);
+    infectiousAgentTable_init(&variantsTable);
+    infectiousAgentTable_addBulk(&variantsTable, variants, 150);
+
+    // The variants 20 to 29 have R0 between 0.12 and 0.129
+    if (infectiousAgentTable_findByR0(&variantsTable, 0.1195, 0.1295, agentsAux, 20) != 10) {
+        failed = true;
+    }
+    for (i = 0; i < 10 && !failed; i++) {
+        if (agentsAux[i] == NULL || strcmp(agentsAux[i]->name, variants[20 + i].name) != 0) {
+            failed = true;
+        }
+    }
+    if (infectiousAgentTable_findByR0(&variantsTable, 0.1195, 0.1295, agentsAux, 4) != 4 ||
+        infectiousAgentTable_findByR0(&variantsTable, 0.5, 0.6, agentsAux, 20) != 0) {
+        failed = true;
+    }
+
+    // The index is updated when agents are added and removed
+    infectiousAgentTable_add(&variantsTable, &influenzaA1);
+    infectiousAgentTable_remove(&variantsTable, &variants[148]);
+    infectiousAgentTable_setRemoveMode(&variantsTable, REMOVE_SWAP);
+    infectiousAgentTable_remove(&variantsTable, &variants[0]);
+    infectiousAgentTable_setRemoveMode(&variantsTable, REMOVE_TOMBSTONE);
+    infectiousAgentTable_remove(&variantsTable, &variants[146]);
+    if (infectiousAgentTable_topR0(&variantsTable, 4, agentsAux) != 4 ||
+        strcmp(agentsAux[0]->name, variants[149].name) != 0 || strcmp(agentsAux[1]->name, variants[147].name) != 0 ||
+        strcmp(agentsAux[2]->name, variants[145].name) != 0 || strcmp(agentsAux[3]->name, variants[144].name) != 0) {
+        failed = true;
+    }
+    if (infectiousAgentTable_findByR0(&variantsTable, 0.1995, 0.2005, agentsAux, 20) != 2 ||
+        infectiousAgentTable_findByR0(&variantsTable, 0.0, 0.1005, agentsAux, 20) != 0 ||
+        infectiousAgentTable_topR0(&variantsTable, 1000, agentsAux) != 148) {
+        failed = true;
+    }
+
+    if (failed) {
+        end_test(test_section, "PR1_EX3_9", false);
+        passed = false;
+    }
+    else {
+        end_test(test_section, "PR1_EX3_9", true);
+    }
+
     // Remove used memory
+    infectiousAgentTable_free(&variantsTable);
+    for (i = 0; i < 200; i++) {
+        infectiousAgent_free(&variants[i]);
+    }
     infectiousAgentTable_free(&infectiousAgentTable);
     infectiousAgent_free(&influenzaA1);
     infectiousAgent_free(&influenzaA2);
@@ -538,13 +1040,31 @@ bool run_pr1_ex3(tTestSection* test_section) {
 bool run_pr1_ex4(tTestSection* test_section) {
     bool passed = true, failed = false;
     tInfectiousAgent COVID_19, ebola;
-    tInfection COVID_19_China = { NULL, NULL, NULL, 0, 0, 0, 0 };
-    tInfection COVID_19_SouthKorea = { NULL, NULL, NULL, 0, 0, 0, 0 };
-    tInfection COVID_19_Italy = { NULL, NULL, NULL, 0, 0, 0, 0 };
-    tInfection ebola_Sierra_Leone = { NULL, NULL, NULL, 0, 0, 0, 0 };
-    tInfection ebola_Liberia = { NULL, NULL, NULL, 0, 0, 0, 0 };
-    tInfection ebola_Guinea = { NULL, NULL, NULL, 0, 0, 0, 0 };
-    tInfection COVID_19_copy = { NULL, NULL, NULL, 0, 0, 0, 0 };
+    tInfection COVID_19_China = { NULL, NULL, NULL, 0, 0, 0, 0, false, NULL };
+    tInfection COVID_19_SouthKorea = { NULL, NULL, NULL, 0, 0, 0, 0, false, NULL };
+    tInfection COVID_19_Italy = { NULL, NULL, NULL, 0, 0, 0, 0, false, NULL };
+    tInfection ebola_Sierra_Leone = { NULL, NULL, NULL, 0, 0, 0, 0, false, NULL };
+    tInfection ebola_Liberia = { NULL, NULL, NULL, 0, 0, 0, 0, false, NULL };
+    tInfection ebola_Guinea = { NULL, NULL, NULL, 0, 0, 0, 0, false, NULL };
+    tInfection COVID_19_copy = { NULL, NULL, NULL, 0, 0, 0, 0, false, NULL };
+    tInfection COVID_19_handle = { NULL, NULL, NULL, 0, 0, 0, 0, false, NULL };
+    tInfection ebola_handle = { NULL, NULL, NULL, 0, 0, 0, 0, false, NULL };
+    tInfectionTable handlesTable;
+    tInfectionTable bigTable1, bigTable2;
+    tInfection bigInfection;
+    tCountry bigCountries[50];
+    char name[32];
+    int i, j;
+    tInfection *expected;
+    long cases, deaths;
+    tGroupResult groups, partitionedGroups;
+    tGroupRow *group, *partitionedGroup;
+    tRemoveMode mode;
+    tInfection *kept;
+    tRegistry registry;
+    tInfectiousAgent variant, *borrowedAgent;
+    tCountry country, *borrowedCountry;
+    unsigned int slots;
 
 
     tInfection *infectionAux;
@@ -852,6 +1372,428 @@ bool run_pr1_ex4(tTestSection* test_section) {
         end_test(test_section, "PR1_EX4_10", true);
     }
 
+    // TEST 11: Add infections as handles to their infectious agent and country
+    failed = false;
+
+    start_test(test_section, "PR1_EX4_11", "Add infections as handles");
+
+    infectionTable_init(&handlesTable);
+    err = infection_initHandle(&COVID_19_handle, &COVID_19, &italy, &dateOutbreak);
+    if (err != OK || !COVID_19_handle.borrowed || COVID_19_handle.infectiousAgent != &COVID_19 || COVID_19_handle.country != &italy) {
+        failed = true;
+    }
+    err = infection_initHandle(&ebola_handle, &ebola, &guinea, &dateOutbreak);
+    if (err != OK) {
+        failed = true;
+    }
+
+    // The table keeps handles, pointing to the same infectious agent and country
+    if (infectionTable_add(&handlesTable, &COVID_19_handle) != OK || infectionTable_add(&handlesTable, &ebola_handle) != OK) {
+        failed = true;
+    }
+    if (infectionTable_add(&handlesTable, &COVID_19_handle) != ERR_DUPLICATED) {
+        failed = true;
+    }
+    infectionAux = infectionTable_find(&handlesTable, "SARS-CoV-2", &italy);
+    if (infectionAux == NULL || !infectionAux->borrowed || infectionAux->infectiousAgent != &COVID_19 || infectionAux->country != &italy) {
+        failed = true;
+    }
+    else {
+        infection_update(infectionAux, 100, 10, 5, 20);
+        if (infectionTable_getMortalityRate(&handlesTable, "SARS-CoV-2") != 0.1f) {
+            failed = true;
+        }
+    }
+
+    // Removing a handle keeps the following ones as handles
+    if (infectionTable_remove(&handlesTable, &COVID_19_handle) != OK || infectionTable_size(&handlesTable) != 1) {
+        failed = true;
+    }
+    infectionAux = infectionTable_find(&handlesTable, "Ebola", &guinea);
+    if (infectionAux == NULL || !infectionAux->borrowed || infectionAux->infectiousAgent != &ebola) {
+        failed = true;
+    }
+
+    // Freeing the handles does not free the infectious agents and countries
+    infectionTable_free(&handlesTable);
+    infection_free(&COVID_19_handle);
+    infection_free(&ebola_handle);
+    if (COVID_19_handle.infectiousAgent != NULL || strcmp(COVID_19.name, "SARS-CoV-2") != 0 || strcmp(italy.name, "Italy") != 0) {
+        failed = true;
+    }
+
+    if (failed) {
+        end_test(test_section, "PR1_EX4_11", false);
+        passed = false;
+    }
+    else {
+        end_test(test_section, "PR1_EX4_11", true);
+    }
+
+    // TEST 12: Find and compare big tables of infections
+    failed = false;
+
+    start_test(test_section, "PR1_EX4_12", "Find and compare big tables of infections");
+
+    infectionTable_init(&bigTable1);
+    infectionTable_init(&bigTable2);
+    for (i = 0; i < 50; i++) {
+        sprintf(name, "country %d", i);
+        country_init(&bigCountries[i], name);
+    }
+    for (i = 0; i < 50; i++) {
+        infection_initHandle(&bigInfection, &COVID_19, &bigCountries[i], &dateOutbreak);
+        infectionTable_add(&bigTable1, &bigInfection);
+        infection_free(&bigInfection);
+        infection_initHandle(&bigInfection, &ebola, &bigCountries[i], &dateOutbreak);
+        infectionTable_add(&bigTable1, &bigInfection);
+        infection_free(&bigInfection);
+
+        // The second table has the same infections in reverse order
+        infection_initHandle(&bigInfection, &ebola, &bigCountries[49 - i], &dateOutbreak);
+        infectionTable_add(&bigTable2, &bigInfection);
+        infection_free(&bigInfection);
+        infection_initHandle(&bigInfection, &COVID_19, &bigCountries[49 - i], &dateOutbreak);
+        infectionTable_add(&bigTable2, &bigInfection);
+        infection_free(&bigInfection);
+    }
+
+    if (infectionTable_size(&bigTable1) != 100 || !infectionTable_equals(&bigTable1, &bigTable2)) {
+        failed = true;
+    }
+
+    // Adding an infection again is detected by the index
+    infection_initHandle(&bigInfection, &ebola, &bigCountries[7], &dateOutbreak);
+    if (infectionTable_add(&bigTable1, &bigInfection) != ERR_DUPLICATED) {
+        failed = true;
+    }
+
+    // Removing infections moves the following ones, and they can still be found
+    if (infectionTable_remove(&bigTable1, &bigInfection) != OK || infectionTable_find(&bigTable1, "Ebola", &bigCountries[7]) != NULL) {
+        failed = true;
+    }
+    infection_free(&bigInfection);
+    infection_initHandle(&bigInfection, &COVID_19, &bigCountries[0], &dateOutbreak);
+    if (infectionTable_remove(&bigTable1, &bigInfection) != OK || infectionTable_size(&bigTable1) != 98) {
+        failed = true;
+    }
+    infection_free(&bigInfection);
+    for (i = 1; i < 50; i++) {
+        infectionAux = infectionTable_find(&bigTable1, "SARS-CoV-2", &bigCountries[i]);
+        if (infectionAux == NULL || infectionAux->infectiousAgent != &COVID_19 || infectionAux->country != &bigCountries[i]) {
+            failed = true;
+        }
+        infectionAux = infectionTable_find(&bigTable1, "Ebola", &bigCountries[i]);
+        if (i != 7 && (infectionAux == NULL || infectionAux->infectiousAgent != &ebola || infectionAux->country != &bigCountries[i])) {
+            failed = true;
+        }
+    }
+    if (infectionTable_equals(&bigTable1, &bigTable2)) {
+        failed = true;
+    }
+
+    infectionTable_free(&bigTable1);
+    infectionTable_free(&bigTable2);
+    for (i = 0; i < 50; i++) {
+        country_free(&bigCountries[i]);
+    }
+
+    if (failed) {
+        end_test(test_section, "PR1_EX4_12", false);
+        passed = false;
+    }
+    else {
+        end_test(test_section, "PR1_EX4_12", true);
+    }
+
+    // TEST 13: Keep the max infection and the mortality rate of each infectious agent while infections are updated
+    failed = false;
+
+    start_test(test_section, "PR1_EX4_13", "Keep the rollups of the infectious agents");
+
+    infectionTable_init(&bigTable1);
+    for (i = 0; i < 30; i++) {
+        sprintf(name, "country %d", i);
+        country_init(&bigCountries[i], name);
+        infection_initHandle(&bigInfection, (i % 3 == 0) ? &ebola : &COVID_19, &bigCountries[i], &dateOutbreak);
+        infectionTable_add(&bigTable1, &bigInfection);
+        infection_free(&bigInfection);
+    }
+
+    for (j = 0; j < 200 && !failed; j++) {
+        // Update an infection, sometimes calculating again its totals from the (empty) country
+        i = (j * 7) % 30;
+        infectionAux = infectionTable_find(&bigTable1, (i % 3 == 0) ? "Ebola" : "SARS-CoV-2", &bigCountries[i]);
+        if (infectionAux == NULL) {
+            // Only the removed infection is missing
+            failed = (j <= 100 || i != 10);
+        }
+        else if (j % 17 == 0) {
+            infection_update_recursive(infectionAux);
+        }
+        else {
+            infection_update(infectionAux, (j * 31) % 11, (j * 13) % 3, 0, 0);
+        }
+        if (j == 100) {
+            infection_initHandle(&bigInfection, &COVID_19, &bigCountries[i], &dateOutbreak);
+            infectionTable_remove(&bigTable1, &bigInfection);
+            infection_free(&bigInfection);
+        }
+
+        // Compare with a scan of the table. In case of tie, the first infection is the max.
+        expected = NULL;
+        cases = 0;
+        deaths = 0;
+        for (i = 0; i < infectionTable_size(&bigTable1); i++) {
+            infectionAux = &bigTable1.elements[i];
+            if (infectionAux->infectiousAgent != &COVID_19) {
+                continue;
+            }
+            cases += infectionAux->totalCases;
+            deaths += infectionAux->totalDeaths;
+            if (infectionAux->totalCases + infectionAux->totalDeaths > 0 && (expected == NULL || infectionAux->totalCases > expected->totalCases ||
+                (infectionAux->totalCases == expected->totalCases && infectionAux->totalDeaths > expected->totalDeaths))) {
+                expected = infectionAux;
+            }
+        }
+        if (infectionTable_getMaxInfection(&bigTable1, "SARS-CoV-2") != expected) {
+            failed = true;
+        }
+        if (cases > 0 && infectionTable_getMortalityRate(&bigTable1, "SARS-CoV-2") != (float)deaths / (float)cases) {
+            failed = true;
+        }
+    }
+    if (infectionTable_getMaxInfection(&bigTable1, "MERS") != NULL) {
+        failed = true;
+    }
+
+    infectionTable_free(&bigTable1);
+    for (i = 0; i < 30; i++) {
+        country_free(&bigCountries[i]);
+    }
+
+    if (failed) {
+        end_test(test_section, "PR1_EX4_13", false);
+        passed = false;
+    }
+    else {
+        end_test(test_section, "PR1_EX4_13", true);
+    }
+
+    // TEST 14: Aggregate the infections of all the infectious agents and countries at once
+    failed = false;
+
+    start_test(test_section, "PR1_EX4_14", "Group infections by infectious agent and country");
+
+    groupResult_init(&groups);
+    groupResult_init(&partitionedGroups);
+
+    // One group for each agent, in the order of their first infection, with the same values as the queries of a single agent
+    if (infectionTable_groupBy(&infectionsTable, GROUP_BY_AGENT, AGGREGATE_ALL, 1, &groups) != OK || groupResult_size(&groups) != 2) {
+        failed = true;
+    }
+    else if (strcmp(groups.rows[0].name, "SARS-CoV-2") != 0 || strcmp(groups.rows[1].name, "Ebola") != 0) {
+        failed = true;
+    }
+    group = groupResult_find(&groups, "Ebola");
+    if (group == NULL || group->count != 3 || group->cases != 23800 || group->deaths != 11265 || group->recovered != 12535 ||
+        group->maxInfection != infectionTable_getMaxInfection(&infectionsTable, "Ebola") ||
+        group->mortalityRate != infectionTable_getMortalityRate(&infectionsTable, "Ebola") || group->criticalRatio != 0.0f) {
+        failed = true;
+    }
+    group = groupResult_find(&groups, "SARS-CoV-2");
+    if (group == NULL || group->maxInfection != infectionTable_getMaxInfection(&infectionsTable, "SARS-CoV-2") ||
+        group->mortalityRate != infectionTable_getMortalityRate(&infectionsTable, "SARS-CoV-2")) {
+        failed = true;
+    }
+
+    // Splitting the table in partitions gives the same result. With OpenMP, each partition runs on its own thread, even if there is a single processor.
+    for (j = 2; j <= 8; j++) {
+        if (infectionTable_groupBy(&infectionsTable, GROUP_BY_AGENT, AGGREGATE_ALL, j, &partitionedGroups) != OK || groupResult_size(&partitionedGroups) != groupResult_size(&groups)) {
+            failed = true;
+            continue;
+        }
+        for (i = 0; i < groupResult_size(&groups); i++) {
+            group = &groups.rows[i];
+            partitionedGroup = &partitionedGroups.rows[i];
+            if (strcmp(group->name, partitionedGroup->name) != 0 || group->count != partitionedGroup->count || group->cases != partitionedGroup->cases ||
+                group->deaths != partitionedGroup->deaths || group->maxInfection != partitionedGroup->maxInfection || group->mortalityRate != partitionedGroup->mortalityRate) {
+                failed = true;
+            }
+        }
+    }
+
+    // Only the requested aggregates are calculated
+    if (infectionTable_groupBy(&infectionsTable, GROUP_BY_COUNTRY, AGGREGATE_CASES, 2, &groups) != OK || groupResult_size(&groups) != infectionTable_size(&infectionsTable)) {
+        failed = true;
+    }
+    group = groupResult_find(&groups, "Liberia");
+    if (group == NULL || group->cases != 10000 || group->deaths != 0 || group->count != 0 || group->maxInfection != NULL || groupResult_find(&groups, "Ebola") != NULL) {
+        failed = true;
+    }
+
+    groupResult_free(&groups);
+    groupResult_free(&partitionedGroups);
+
+    if (failed) {
+        end_test(test_section, "PR1_EX4_14", false);
+        passed = false;
+    }
+    else {
+        end_test(test_section, "PR1_EX4_14", true);
+    }
+
+    // TEST 15: Remove infections in all the remove modes
+    failed = false;
+
+    start_test(test_section, "PR1_EX4_15", "Remove infections in all the remove modes");
+
+    for (i = 0; i < 10; i++) {
+        sprintf(name, "country %d", i);
+        country_init(&bigCountries[i], name);
+    }
+    for (mode = REMOVE_SHIFT; mode <= REMOVE_TOMBSTONE; mode++) {
+        infectionTable_init(&bigTable1);
+        infectionTable_setRemoveMode(&bigTable1, mode);
+        for (i = 0; i < 20; i++) {
+            infection_initHandle(&bigInfection, (i % 2 == 0) ? &COVID_19 : &ebola, &bigCountries[i / 2], &dateOutbreak);
+            infectionTable_add(&bigTable1, &bigInfection);
+            infection_free(&bigInfection);
+            infection_update(&bigTable1.elements[i], 100 * (i % 7), i, 0, 0);
+        }
+        kept = infectionTable_find(&bigTable1, "Ebola", &bigCountries[9]);
+
+        // Remove the infections of the even countries, the first one included
+        for (i = 0; i < 10; i += 2) {
+            infection_initHandle(&bigInfection, &COVID_19, &bigCountries[i], &dateOutbreak);
+            if (infectionTable_remove(&bigTable1, &bigInfection) != OK || infectionTable_remove(&bigTable1, &bigInfection) != ERR_NOT_FOUND) {
+                failed = true;
+            }
+            infection_free(&bigInfection);
+        }
+        if (infectionTable_size(&bigTable1) != 15) {
+            failed = true;
+        }
+
+        // Tombstones do not move the other infections
+        if (mode == REMOVE_TOMBSTONE && (bigTable1.size != 20 || infectionTable_find(&bigTable1, "Ebola", &bigCountries[9]) != kept)) {
+            failed = true;
+        }
+
+        // The index, the totals and the rollups of the moved infections are kept
+        for (i = 0; i < 20; i++) {
+            infectionAux = infectionTable_find(&bigTable1, (i % 2 == 0) ? "SARS-CoV-2" : "Ebola", &bigCountries[i / 2]);
+            if ((i % 4 == 0) != (infectionAux == NULL)) {
+                failed = true;
+            }
+            if (infectionAux != NULL && (infectionAux->country != &bigCountries[i / 2] || infectionAux->totalCases != 100 * (i % 7) || infectionAux->totalDeaths != i)) {
+                failed = true;
+            }
+        }
+        if (infectionTable_getMortalityRate(&bigTable1, "SARS-CoV-2") != 50.0f / 1500.0f || infectionTable_getMaxInfection(&bigTable1, "Ebola") != infectionTable_find(&bigTable1, "Ebola", &bigCountries[6])) {
+            failed = true;
+        }
+
+        // Shifting keeps the order of the table. Leaving the tombstone mode compacts the table, also keeping the order.
+        if (mode == REMOVE_TOMBSTONE) {
+            infectionTable_setRemoveMode(&bigTable1, REMOVE_SHIFT);
+        }
+        if (mode != REMOVE_SWAP) {
+            for (i = 1; i < infectionTable_size(&bigTable1); i++) {
+                if (bigTable1.elements[i - 1].country > bigTable1.elements[i].country) {
+                    failed = true;
+                }
+            }
+        }
+        if (bigTable1.size != 15 || infectionTable_getMaxInfection(&bigTable1, "Ebola") != infectionTable_find(&bigTable1, "Ebola", &bigCountries[6])) {
+            failed = true;
+        }
+
+        infectionTable_free(&bigTable1);
+    }
+    for (i = 0; i < 10; i++) {
+        country_free(&bigCountries[i]);
+    }
+
+    if (failed) {
+        end_test(test_section, "PR1_EX4_15", false);
+        passed = false;
+    }
+    else {
+        end_test(test_section, "PR1_EX4_15", true);
+    }
+
+    // TEST 16: Borrow infectious agents and countries from a registry
+    failed = false;
+
+    start_test(test_section, "PR1_EX4_16", "Borrow infectious agents and countries from a registry");
+
+    registry_init(&registry);
+    if (registry_addAgent(&registry, &ebola) != OK || registry_addAgent(&registry, &COVID_19) != OK || registry_addAgent(&registry, &COVID_19) != ERR_DUPLICATED) {
+        failed = true;
+    }
+    if (registry_addCountry(&registry, &guinea) != OK || registry_addCountry(&registry, &italy) != OK || registry_addCountry(&registry, &italy) != ERR_DUPLICATED) {
+        failed = true;
+    }
+    borrowedAgent = registry_findAgent(&registry, "SARS-CoV-2");
+    borrowedCountry = registry_findCountry(&registry, "Italy");
+    if (borrowedAgent == NULL || borrowedCountry == NULL || !infectiousAgent_equals(borrowedAgent, &COVID_19) || !country_equal(borrowedCountry, &italy)) {
+        failed = true;
+    }
+    else {
+        infection_initHandle(&bigInfection, borrowedAgent, borrowedCountry, &dateOutbreak);
+
+        // Grow the registry and remove other elements. The borrowed agent and country are not moved.
+        for (i = 0; i < 300; i++) {
+            sprintf(name, "variant %d", i);
+            infectiousAgent_init(&variant, name, 0.5, "Air", &dateOutbreak, "Wuhan", &reservoirList);
+            sprintf(name, "country %d", i);
+            country_init(&country, name);
+            if (registry_addAgent(&registry, &variant) != OK || registry_addCountry(&registry, &country) != OK) {
+                failed = true;
+            }
+            infectiousAgent_free(&variant);
+            country_free(&country);
+        }
+        if (registry_removeAgent(&registry, "Ebola") != OK || registry_removeAgent(&registry, "Ebola") != ERR_NOT_FOUND || registry_removeCountry(&registry, "Guinea") != OK) {
+            failed = true;
+        }
+        for (i = 0; i < 300; i += 2) {
+            sprintf(name, "variant %d", i);
+            registry_removeAgent(&registry, name);
+            sprintf(name, "country %d", i);
+            registry_removeCountry(&registry, name);
+        }
+
+        if (registry_findAgent(&registry, "SARS-CoV-2") != borrowedAgent || registry_findCountry(&registry, "Italy") != borrowedCountry ||
+            strcmp(bigInfection.infectiousAgent->name, "SARS-CoV-2") != 0 || bigInfection.infectiousAgent->r0 != COVID_19.r0 ||
+            strcmp(bigInfection.country->name, "Italy") != 0 || !country_equal(bigInfection.country, &italy)) {
+            failed = true;
+        }
+        if (registry_findAgent(&registry, "variant 2") != NULL || registry_findAgent(&registry, "variant 3") == NULL || registry_findCountry(&registry, "Guinea") != NULL) {
+            failed = true;
+        }
+
+        // The slots of the removed elements are reused
+        slots = registry.agents.size;
+        infectiousAgent_init(&variant, "variant 2", 0.5, "Air", &dateOutbreak, "Wuhan", &reservoirList);
+        if (registry_addAgent(&registry, &variant) != OK || registry.agents.size != slots) {
+            failed = true;
+        }
+        infectiousAgent_free(&variant);
+
+        infection_free(&bigInfection);
+    }
+    registry_free(&registry);
+
+    if (failed) {
+        end_test(test_section, "PR1_EX4_16", false);
+        passed = false;
+    }
+    else {
+        end_test(test_section, "PR1_EX4_16", true);
+    }
+
     // Remove used memory   
 
     infectionTable_free(&infectionsTable);
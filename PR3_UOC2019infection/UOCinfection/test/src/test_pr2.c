@@ -1,5 +1,6 @@
 #include <assert.h>
 #include <string.h>
+#include <stdio.h>
 #include "test_pr2.h"
 #include "reservoir.h"
 #include "infectiousAgent.h"
@@ -32,8 +33,10 @@ bool run_pr2_ex1(tTestSection* test_section) {
     bool passed = true, failed = false;
     tError err;
     tCityList cities;
-    tCity cityNewYok, cityMilan, cityFoo;
+    tCity cityNewYok, cityMilan, cityFoo, cityAux;
     tDate date;
+    char name[32];
+    int i;
 
     // TEST 1: Create List
     failed = false;
@@ -181,6 +184,52 @@ bool run_pr2_ex1(tTestSection* test_section) {
         end_test(test_section, "PR2_EX1_6", true);
     }
 
+    // TEST 7: Append many cities
+    failed = false;
+    start_test(test_section, "PR2_EX1_7", "Append many cities at the end of the list");
+
+    cityList_free(&cities);
+    for (i = 0; i < 1000 && !failed; i++) {
+        sprintf(name, "City %d", i);
+        city_init(&cityAux, name, &date, 1000, 0, 0, 0, 0, 10);
+        if (cityList_insert(&cities, &cityAux, cityList_size(&cities)) != OK) {
+            failed = true;
+        }
+        city_free(&cityAux);
+    }
+
+    if (cityList_size(&cities) != 1000 || cities.last == NULL || strcmp(cities.last->city->name, "City 999") != 0 ||
+        strcmp(cityList_get(&cities, 999)->name, "City 999") != 0 || cityList_get(&cities, 1000) != NULL) {
+        failed = true;
+    }
+
+    // Deleting the last city, the previous one is the new last city
+    if (!cityList_delete(&cities, 999) || cityList_size(&cities) != 999 || strcmp(cities.last->city->name, "City 998") != 0) {
+        failed = true;
+    }
+    if (cityList_delete(&cities, 999)) {
+        failed = true;
+    }
+    sprintf(name, "City %d", 1000);
+    city_init(&cityAux, name, &date, 1000, 0, 0, 0, 0, 10);
+    if (cityList_insert(&cities, &cityAux, 999) != OK || strcmp(cities.last->city->name, "City 1000") != 0) {
+        failed = true;
+    }
+    city_free(&cityAux);
+
+    cityList_free(&cities);
+    if (cityList_size(&cities) != 0 || cities.last != NULL) {
+        failed = true;
+    }
+
+    if (failed) {
+        end_test(test_section, "PR2_EX1_7", false);
+        passed = false;
+    }
+    else {
+        end_test(test_section, "PR2_EX1_7", true);
+    }
+
     // Remove used memory
     cityList_free(&cities);
 
@@ -198,9 +247,18 @@ bool run_pr2_ex2(tTestSection* test_section) {
 
     bool passed = true, failed = false;
     tCityList  cities, emptyCities;
-    tCity cityNewYok, cityMilan, cityLondon, cityFoo;
+    tCity cityNewYok, cityMilan, cityLondon, cityFoo, cityAux;
     tCity * city;
-    tDate date;
+    tCityTotals totals, expected;
+    tCityNode * node;
+    void * block;
+    tCitySeriesEntry history[10];
+    tDate date, dateFrom, dateTo;
+    tWriter writer;
+    FILE * file;
+    char expectedText[512], text[512];
+    char name[32];
+    int i, collapsed;
 
     cityList_create(&cities);
     cityList_create(&emptyCities);
@@ -467,6 +525,278 @@ bool run_pr2_ex2(tTestSection* test_section) {
         end_test(test_section, "PR2_EX2_7", true);
     }
 
+    // TEST 8: find and update cities in a big list
+    failed = false;
+    start_test(test_section, "PR2_EX2_8", "find and update cities in a big list");
+
+    for (i = 0; i < 100; i++) {
+        sprintf(name, "Town %d", i);
+        city_init(&cityAux, name, &date, 1000, 0, 0, 0, 0, 10);
+        cityList_insert(&cities, &cityAux, cityList_size(&cities));
+        city_free(&cityAux);
+    }
+    if (cityList_size(&cities) != 103 || cityList_insert(&cities, &cityLondon, 50) != ERR_DUPLICATED) {
+        failed = true;
+    }
+
+    for (i = 0; i < 100 && !failed; i++) {
+        sprintf(name, "Town %d", i);
+        city = cityList_find(&cities, name);
+        if (city == NULL || strcmp(city->name, name) != 0) {
+            failed = true;
+        }
+    }
+
+    city = cityList_update(&cities, "Town 42", &date, 5, 1, 0, 0);
+    if (city == NULL || city->cases != 5 || cityList_find(&cities, "Town 42")->cases != 5) {
+        failed = true;
+    }
+
+    // Deleted cities cannot be found
+    cityList_delete(&cities, 3);
+    if (cityList_find(&cities, "Town 0") != NULL || cityList_update(&cities, "Town 0", &date, 1, 0, 0, 0) != NULL ||
+        cityList_find(&cities, "Town 1") == NULL || cityList_find(&cities, "London") == NULL) {
+        failed = true;
+    }
+
+    if (failed) {
+        end_test(test_section, "PR2_EX2_8", false);
+        passed = false;
+    }
+    else {
+        end_test(test_section, "PR2_EX2_8", true);
+    }
+
+    // TEST 9: keep the totals of a list
+    failed = false;
+    start_test(test_section, "PR2_EX2_9", "keep the totals of a list");
+
+    // The list has been changed by insert, update and delete
+    totals = cityList_totals(&cities);
+    expected = cityList_recalculateTotals(&cities);
+    if (totals.population != expected.population || totals.cases != expected.cases || totals.critical_cases != expected.critical_cases ||
+        totals.deaths != expected.deaths || totals.recovered != expected.recovered || totals.medical_beds != expected.medical_beds) {
+        failed = true;
+    }
+
+    cityList_update(&cities, "Town 50", &date, 10, 2, 3, 4);
+    cityList_delete(&cities, 0);
+    totals = cityList_totals(&cities);
+    if (totals.cases != expected.cases + 10 - cityNewYok.cases || totals.deaths != expected.deaths + 3 - cityNewYok.deaths ||
+        totals.population != expected.population - 3 - cityNewYok.population || totals.medical_beds != expected.medical_beds - cityNewYok.medical_beds) {
+        failed = true;
+    }
+
+    cityList_free(&emptyCities);
+    totals = cityList_totals(&emptyCities);
+    if (totals.population != 0 || totals.cases != 0 || totals.medical_beds != 0) {
+        failed = true;
+    }
+
+    if (failed) {
+        end_test(test_section, "PR2_EX2_9", false);
+        passed = false;
+    }
+    else {
+        end_test(test_section, "PR2_EX2_9", true);
+    }
+
+    // TEST 10: keep the number of collapsed cities of a list
+    failed = false;
+    start_test(test_section, "PR2_EX2_10", "keep the number of collapsed cities of a list");
+
+    // The number of collapsed cities is kept with the totals, so it is not counted again for each query
+    cityList_update(&cities, "Town 50", &date, 7, 3000, 1, 2);
+    cityList_delete(&cities, 0);
+    collapsed = 0;
+    for (node = cities.first; node != NULL; node = node->next) {
+        if (node->city->critical_cases > node->city->medical_beds) {
+            collapsed++;
+        }
+    }
+    totals = cityList_totals(&cities);
+    expected = cityList_recalculateTotals(&cities);
+    if (collapsed == 0 || totals.collapsed_cities != collapsed || expected.collapsed_cities != collapsed) {
+        failed = true;
+    }
+
+    if (failed) {
+        end_test(test_section, "PR2_EX2_10", false);
+        passed = false;
+    }
+    else {
+        end_test(test_section, "PR2_EX2_10", true);
+    }
+
+    // TEST 11: allocate the cities from the pool of the list
+    failed = false;
+    start_test(test_section, "PR2_EX2_11", "allocate the cities from the pool of the list");
+
+    // Consecutive nodes are taken from the same chunk of the pool
+    cityList_insert(&emptyCities, &cityMilan, 0);
+    cityList_insert(&emptyCities, &cityLondon, 1);
+    if (emptyCities.pool.chunks == NULL || emptyCities.pool.chunks->next != NULL ||
+        (char*)emptyCities.last < (char*)emptyCities.first || (char*)emptyCities.last - (char*)emptyCities.first > 256) {
+        failed = true;
+    }
+
+    // The memory of a deleted city is reused by the next one
+    node = emptyCities.last;
+    cityList_delete(&emptyCities, 1);
+    cityList_insert(&emptyCities, &cityNewYok, 1);
+    if (emptyCities.last != node || cityList_find(&emptyCities, "London") != NULL ||
+        cityList_find(&emptyCities, "New York") == NULL || cityList_find(&emptyCities, "New York")->population != cityNewYok.population) {
+        failed = true;
+    }
+
+    // Big blocks are reused too, by any allocation of the same power of two class
+    block = memPool_alloc(&emptyCities.pool, 1000);
+    memPool_free(&emptyCities.pool, block, 1000);
+    if (block == NULL || memPool_alloc(&emptyCities.pool, 600) != block) {
+        failed = true;
+    }
+
+    // Freeing the list releases the pool, and the list can be used again
+    cityList_free(&emptyCities);
+    if (emptyCities.pool.chunks != NULL || cityList_insert(&emptyCities, &cityMilan, 0) != OK || cityList_size(&emptyCities) != 1) {
+        failed = true;
+    }
+
+    if (failed) {
+        end_test(test_section, "PR2_EX2_11", false);
+        passed = false;
+    }
+    else {
+        end_test(test_section, "PR2_EX2_11", true);
+    }
+
+    // TEST 12: keep the history of a city
+    failed = false;
+    start_test(test_section, "PR2_EX2_12", "keep the history of a city");
+
+    cityList_free(&emptyCities);
+    cityList_insert(&emptyCities, &cityMilan, 0);
+
+    // One update each day of 2020 and the first days of 2021. Only some days have changes
+    date.day = 1;
+    date.month = 1;
+    date.year = 2020;
+    for (i = 0; i < 400; i++) {
+        cityList_update(&emptyCities, "Milan", &date, (i % 3 == 0) ? i : 0, 0, (i % 10 == 0) ? 1 : 0, (i > 300) ? 1000 * i : 0);
+        // Move to the next day
+        date.day++;
+        if (date.day > 31 || (date.day > 30 && (date.month == 4 || date.month == 6 || date.month == 9 || date.month == 11)) ||
+            (date.month == 2 && date.day > ((date.year % 4 == 0) ? 29 : 28))) {
+            date.day = 1;
+            date.month++;
+            if (date.month > 12) {
+                date.month = 1;
+                date.year++;
+            }
+        }
+    }
+
+    // From 28/2/2020 (day 58) to 2/3/2020 (day 61)
+    dateFrom.day = 28;
+    dateFrom.month = 2;
+    dateFrom.year = 2020;
+    dateTo.day = 2;
+    dateTo.month = 3;
+    dateTo.year = 2020;
+    if (cityList_history(&emptyCities, "Milan", &dateFrom, &dateTo, history, 10) != 4 ||
+        history[1].date.day != 29 || history[1].date.month != 2 || history[2].date.day != 1 || history[2].date.month != 3 ||
+        history[0].cases != 0 || history[1].cases != 0 || history[2].cases != 60 || history[3].deaths != 0 || history[2].deaths != 1) {
+        failed = true;
+    }
+
+    // From 30/12/2020 (day 364) to 4/2/2021 (day 399), but only 3 entries are stored
+    dateFrom.day = 30;
+    dateFrom.month = 12;
+    dateTo.day = 4;
+    dateTo.month = 2;
+    dateTo.year = 2021;
+    if (cityList_history(&emptyCities, "Milan", &dateFrom, &dateTo, history, 3) != 36 ||
+        history[0].date.day != 30 || history[0].date.year != 2020 || history[2].date.day != 1 || history[2].date.year != 2021 ||
+        history[0].recovered != 364000 || history[2].recovered != 366000 || history[2].cases != 366) {
+        failed = true;
+    }
+
+    // A report with an older date is still found
+    date.day = 2;
+    date.month = 1;
+    date.year = 2020;
+    cityList_update(&emptyCities, "Milan", &date, 5, 4, 3, 2);
+    dateFrom.day = 1;
+    dateFrom.month = 1;
+    dateFrom.year = 2020;
+    dateTo = date;
+    if (cityList_history(&emptyCities, "Milan", &dateFrom, &dateTo, history, 10) != 3 || history[2].cases != 5 || history[2].critical_cases != 4 ||
+        cityList_history(&emptyCities, "Foo", &dateFrom, &dateTo, history, 10) != -1) {
+        failed = true;
+    }
+
+    if (failed) {
+        end_test(test_section, "PR2_EX2_12", false);
+        passed = false;
+    }
+    else {
+        end_test(test_section, "PR2_EX2_12", true);
+    }
+
+    // TEST 13: write a list of cities
+    failed = false;
+    start_test(test_section, "PR2_EX2_13", "write a list of cities");
+
+    cityList_free(&emptyCities);
+    cityList_insert(&emptyCities, &cityMilan, 0);
+    cityList_insert(&emptyCities, &cityLondon, 1);
+    cityList_update(&emptyCities, "London", cityLondon.last_update, 1234567, 89, 10, 0);
+    sprintf(expectedText, "0 Milan \n \tpopulation:%ld medical_beds:%d updated:%d/%d/%d \n \tcases:%d critical:%d deaths:%d recovered:%d \n "
+        "1 London \n \tpopulation:%ld medical_beds:%d updated:%d/%d/%d \n \tcases:%d critical:%d deaths:%d recovered:%d \n \n ",
+        cityMilan.population, cityMilan.medical_beds, cityMilan.last_update->day, cityMilan.last_update->month, cityMilan.last_update->year,
+        cityMilan.cases, cityMilan.critical_cases, cityMilan.deaths, cityMilan.recovered,
+        cityLondon.population - 10, cityLondon.medical_beds, cityLondon.last_update->day, cityLondon.last_update->month, cityLondon.last_update->year,
+        cityLondon.cases + 1234567, cityLondon.critical_cases + 89, cityLondon.deaths + 10, cityLondon.recovered);
+
+    // Write to memory
+    writer_initMemory(&writer);
+    cityList_write(&emptyCities, &writer);
+    if (writer_error(&writer) != OK || strcmp(writer_data(&writer), expectedText) != 0) {
+        failed = true;
+    }
+    writer_free(&writer);
+
+    // Write to a file, and read it back
+    file = tmpfile();
+    if (file == NULL || writer_initFile(&writer, file) != OK) {
+        failed = true;
+    }
+    else {
+        cityList_write(&emptyCities, &writer);
+        writer_putLong(&writer, -42);
+        if (writer_free(&writer) != OK) {
+            failed = true;
+        }
+        rewind(file);
+        i = (int)fread(text, sizeof(char), sizeof(text) - 1, file);
+        text[i] = '\0';
+        strcat(expectedText, "-42");
+        if (strcmp(text, expectedText) != 0) {
+            failed = true;
+        }
+    }
+    if (file != NULL) {
+        fclose(file);
+    }
+
+    if (failed) {
+        end_test(test_section, "PR2_EX2_13", false);
+        passed = false;
+    }
+    else {
+        end_test(test_section, "PR2_EX2_13", true);
+    }
+
     // Remove used memory
 
     city_free(&cityMilan);
@@ -479,13 +809,25 @@ bool run_pr2_ex2(tTestSection* test_section) {
     return passed;
 }
 
+// Count the times a country enters or leaves health collapse
+static void test_countCollapse(tCountry * country, void * data) {
+    (*(int*)data)++;
+}
+
 // Run tests for PR1 exercice 3
 bool run_pr2_ex3(tTestSection* test_section) {
 
     bool passed = true, failed = false;
     tError err;
-    tCity cityBergamo, cityMilan, cityBrescia, cityComo;
-    tCountry italy;
+    tCity cityBergamo, cityMilan, cityBrescia, cityComo, cityAux;
+    tCountry italy, bigCountry, copy1, copy2, copy3;
+    tCitySeriesEntry history[4];
+    tDate dateFrom, dateTo;
+    tCityTotals totals;
+    tCityReport reports[4];
+    tError status[4];
+    char name[32];
+    int i, transitions;
     tInfectiousAgent COVID_19;
     tInfection COVID_19_Italy = { 0 };
     long country_population = 0;
@@ -663,6 +1005,254 @@ bool run_pr2_ex3(tTestSection* test_section) {
         end_test(test_section, "PR2_EX3_5", true);
     }
 
+    // TEST 6: calculate all the country totals at once
+    failed = false;
+    start_test(test_section, "PR2_EX3_6", "calculate all the country totals at once");
+
+    totals = country_totals(&italy);
+    if (totals.population != country_totalPopulation(&italy) || totals.cases != 45000 || totals.critical_cases != 125 ||
+        totals.deaths != 7700 || totals.recovered != 10500 || totals.medical_beds != 2850) {
+        failed = true;
+    }
+
+    // A big country does not overflow the stack
+    country_init(&bigCountry, "Big country");
+    for (i = 0; i < 100000; i++) {
+        sprintf(name, "Village %d", i);
+        city_init(&cityAux, name, &date, 10, 1, 0, 0, 0, 1);
+        country_addCity(&bigCountry, &cityAux);
+        city_free(&cityAux);
+    }
+    totals = country_totals(&bigCountry);
+    if (totals.population != 1000000l || totals.cases != 100000 || country_totalCases(&bigCountry) != 100000 ||
+        totals.medical_beds != 100000) {
+        failed = true;
+    }
+    country_free(&bigCountry);
+
+    if (failed) {
+        end_test(test_section, "PR2_EX3_6", false);
+        passed = false;
+    }
+    else {
+        end_test(test_section, "PR2_EX3_6", true);
+    }
+
+    // TEST 7: update many cities of a country at once
+    failed = false;
+    start_test(test_section, "PR2_EX3_7", "update many cities of a country at once");
+
+    totals = country_totals(&italy);
+    reports[0].name = "Milan";
+    reports[1].name = "Foo";
+    reports[2].name = "Como";
+    reports[3].name = "Milan";
+    for (i = 0; i < 4; i++) {
+        reports[i].date.day = 10 + i;
+        reports[i].date.month = 5;
+        reports[i].date.year = 2020;
+        reports[i].cases = 100;
+        reports[i].critical_cases = 10;
+        reports[i].deaths = 2;
+        reports[i].recovered = 5;
+    }
+
+    if (country_updateBatch(&italy, reports, 4, status) != 3 || status[0] != OK || status[1] != ERR_NOT_FOUND || status[2] != OK || status[3] != OK) {
+        failed = true;
+    }
+    if (cityList_find(italy.cities, "Milan")->last_update->day != 13 || cityList_find(italy.cities, "Como")->last_update->day != 12) {
+        failed = true;
+    }
+    if (country_totalCases(&italy) != totals.cases + 300 || country_totalCriticalCases(&italy) != totals.critical_cases + 30 ||
+        country_totalDeaths(&italy) != totals.deaths + 6 || country_totalRecovered(&italy) != totals.recovered + 15 ||
+        country_totalPopulation(&italy) != totals.population - 6) {
+        failed = true;
+    }
+    if (country_updateBatch(&italy, reports, 0, NULL) != 0) {
+        failed = true;
+    }
+
+    if (failed) {
+        end_test(test_section, "PR2_EX3_7", false);
+        passed = false;
+    }
+    else {
+        end_test(test_section, "PR2_EX3_7", true);
+    }
+
+    // TEST 8: detect the health collapse of a country
+    failed = false;
+    start_test(test_section, "PR2_EX3_8", "detect the health collapse of a country");
+
+    transitions = 0;
+    country_init(&bigCountry, "Small country");
+    country_setCollapseCallback(&bigCountry, test_countCollapse, &transitions);
+    city_init(&cityAux, "Village A", &date, 1000, 0, 0, 0, 0, 10);
+    country_addCity(&bigCountry, &cityAux);
+    city_free(&cityAux);
+    city_init(&cityAux, "Village B", &date, 1000, 0, 0, 0, 0, 10);
+    country_addCity(&bigCountry, &cityAux);
+    city_free(&cityAux);
+    if (bigCountry.health_collapse || transitions != 0) {
+        failed = true;
+    }
+
+    // A city with more critical cases than medical beds collapses the country
+    cityList_update(bigCountry.cities, "Village A", &date, 20, 11, 0, 0);
+    if (!bigCountry.health_collapse || transitions != 1 || country_totals(&bigCountry).collapsed_cities != 1) {
+        failed = true;
+    }
+    cityList_update(bigCountry.cities, "Village A", &date, 5, 5, 0, 0);
+    if (!bigCountry.health_collapse || transitions != 1) {
+        failed = true;
+    }
+
+    // With a threshold of 2 cities, the country needs another collapsed city
+    country_setCollapseThreshold(&bigCountry, 2);
+    if (bigCountry.health_collapse || transitions != 2) {
+        failed = true;
+    }
+    reports[0].name = "Village B";
+    reports[0].cases = 30;
+    reports[0].critical_cases = 30;
+    reports[0].deaths = 0;
+    reports[0].recovered = 0;
+    country_updateBatch(&bigCountry, reports, 1, NULL);
+    if (!bigCountry.health_collapse || transitions != 3 || country_totals(&bigCountry).collapsed_cities != 2) {
+        failed = true;
+    }
+
+    // Deleting a collapsed city ends the collapse
+    cityList_delete(bigCountry.cities, 0);
+    if (bigCountry.health_collapse || transitions != 4 || country_totals(&bigCountry).collapsed_cities != 1) {
+        failed = true;
+    }
+    country_free(&bigCountry);
+    if (transitions != 4) {
+        failed = true;
+    }
+
+    if (failed) {
+        end_test(test_section, "PR2_EX3_8", false);
+        passed = false;
+    }
+    else {
+        end_test(test_section, "PR2_EX3_8", true);
+    }
+
+    // TEST 9: share the cities of copied countries
+    failed = false;
+    start_test(test_section, "PR2_EX3_9", "share the cities of copied countries");
+
+    // Copies of a country that does not change share a single copy of its cities
+    country_cpy(&copy1, &italy);
+    country_cpy(&copy2, &italy);
+    country_cpy(&copy3, &copy1);
+    if (copy1.cities->source == NULL || copy1.cities->source != copy2.cities->source || copy3.cities->source != copy1.cities->source ||
+        cityList_size(copy1.cities) != cityList_size(italy.cities) || copy1.health_collapse != italy.health_collapse) {
+        failed = true;
+    }
+
+    // Changing the original country does not change the copies
+    totals = country_totals(&italy);
+    cityList_update(italy.cities, "Milan", &date, 1000, 0, 0, 0);
+    if (country_totalCases(&copy1) != totals.cases || country_totalCases(&italy) != totals.cases + 1000) {
+        failed = true;
+    }
+
+    // A copy that changes gets its own cities
+    city_init(&cityAux, "Cremona", &date, 72000, 0, 0, 0, 0, 300);
+    country_addCity(&copy2, &cityAux);
+    city_free(&cityAux);
+    if (copy2.cities->source != NULL || cityList_find(copy2.cities, "Cremona") == NULL || cityList_find(copy1.cities, "Cremona") != NULL ||
+        cityList_size(copy1.cities) != cityList_size(copy3.cities)) {
+        failed = true;
+    }
+
+    // New copies of the changed country do not use the old shared cities
+    country_free(&copy3);
+    country_cpy(&copy3, &italy);
+    if (copy3.cities->source == copy1.cities->source || country_totalCases(&copy3) != totals.cases + 1000) {
+        failed = true;
+    }
+
+    country_free(&copy1);
+    country_free(&copy2);
+    country_free(&copy3);
+
+    if (failed) {
+        end_test(test_section, "PR2_EX3_9", false);
+        passed = false;
+    }
+    else {
+        end_test(test_section, "PR2_EX3_9", true);
+    }
+
+    // TEST 10: change copied countries with the functions of the lists
+    failed = false;
+    start_test(test_section, "PR2_EX3_10", "change copied countries with the functions of the lists");
+
+    dateFrom.day = 1; dateFrom.month = 1; dateFrom.year = 1900;
+    dateTo.day = 31; dateTo.month = 12; dateTo.year = 2100;
+
+    // A copy of a changed copy keeps working when the first copy changes again and is freed
+    country_cpy(&copy1, &italy);
+    city_init(&cityAux, "Lodi", &date, 45000, 0, 0, 0, 0, 100);
+    country_addCity(&copy1, &cityAux);
+    city_free(&cityAux);
+    country_cpy(&copy2, &copy1);
+    city_init(&cityAux, "Pavia", &date, 73000, 0, 0, 0, 0, 200);
+    country_addCity(&copy1, &cityAux);
+    city_free(&cityAux);
+    country_free(&copy1);
+    if (cityList_update(copy2.cities, "Lodi", &date, 10, 0, 0, 0) == NULL || cityList_find(copy2.cities, "Pavia") != NULL) {
+        failed = true;
+    }
+
+    // The functions of the list only change the copy they are given
+    country_cpy(&copy1, &copy2);
+    country_cpy(&copy3, &copy2);
+    if (cityList_update(copy1.cities, "Lodi", &date, 5, 0, 0, 0) == NULL || cityList_find(copy1.cities, "Lodi")->cases != 15 ||
+        cityList_find(copy2.cities, "Lodi")->cases != 10 || cityList_find(copy3.cities, "Lodi")->cases != 10) {
+        failed = true;
+    }
+    if (!cityList_delete(copy3.cities, 0) || cityList_size(copy3.cities) != cityList_size(copy2.cities) - 1) {
+        failed = true;
+    }
+
+    // A batch that changes no city of a copy keeps using the shared cities
+    country_free(&copy3);
+    country_cpy(&copy3, &copy2);
+    reports[0].name = "Atlantis";
+    reports[0].date = date;
+    reports[0].cases = 1;
+    reports[0].critical_cases = 0;
+    reports[0].deaths = 0;
+    reports[0].recovered = 0;
+    if (cityList_updateBatch(copy3.cities, reports, 0, status) != 0 || cityList_updateBatch(copy3.cities, reports, 1, status) != 0 ||
+        status[0] != ERR_NOT_FOUND || copy3.cities->source == NULL) {
+        failed = true;
+    }
+
+    // The copies keep the history of the cities
+    if (cityList_history(copy1.cities, "Lodi", &dateFrom, &dateTo, history, 4) != 2 || history[0].cases != 10 || history[1].cases != 5 ||
+        cityList_history(copy2.cities, "Lodi", &dateFrom, &dateTo, history, 4) != 1 ||
+        cityList_history(copy1.cities, "Milan", &dateFrom, &dateTo, history, 4) != cityList_history(italy.cities, "Milan", &dateFrom, &dateTo, history, 4)) {
+        failed = true;
+    }
+
+    country_free(&copy1);
+    country_free(&copy2);
+    country_free(&copy3);
+
+    if (failed) {
+        end_test(test_section, "PR2_EX3_10", false);
+        passed = false;
+    }
+    else {
+        end_test(test_section, "PR2_EX3_10", true);
+    }
+
 
     // Remove used memory
     city_free(&cityMilan);
@@ -3,6 +3,8 @@
 ## any manual changes will be erased      
 ##
 ## Debug
+## OpenMP runs the partitions of infectionTable_groupBy in parallel. It is used only if the compiler supports it, and it can be disabled with "make OpenMPSwitch="
+OpenMPSwitch           ?=$(shell echo "int main(void) { return 0; }" | gcc -fopenmp -x c - -o /dev/null 2>/dev/null && echo -fopenmp)
 ProjectName            :=UOCinfectiousAgent
 ConfigurationName      :=Debug
 WorkspacePath          :=/home/uoc/Documents/codelite/workspaces/UOC2019infection
@@ -50,8 +52,8 @@ LibPath                := $(LibraryPathSwitch).
 AR       := ar rcus
 CXX      := gcc
 CC       := gcc
-CXXFLAGS :=  -g -O0 -Wall $(Preprocessors)
-CFLAGS   :=  -g -O0 -Wall $(Preprocessors)
+CXXFLAGS :=  -g -O0 -Wall $(OpenMPSwitch) $(Preprocessors)
+CFLAGS   :=  -g -O0 -Wall $(OpenMPSwitch) $(Preprocessors)
 ASFLAGS  := 
 AS       := as
 
@@ -60,7 +62,7 @@ AS       := as
 ## User defined environment variables
 ##
 CodeLiteDir:=/usr/share/codelite
-Objects0=$(IntermediateDirectory)/src_research.c$(ObjectSuffix) $(IntermediateDirectory)/src_country.c$(ObjectSuffix) $(IntermediateDirectory)/src_city.c$(ObjectSuffix) $(IntermediateDirectory)/src_infection.c$(ObjectSuffix) $(IntermediateDirectory)/src_infectiousAgent.c$(ObjectSuffix) $(IntermediateDirectory)/src_reservoir.c$(ObjectSuffix) 
+Objects0=$(IntermediateDirectory)/src_research.c$(ObjectSuffix) $(IntermediateDirectory)/src_country.c$(ObjectSuffix) $(IntermediateDirectory)/src_city.c$(ObjectSuffix) $(IntermediateDirectory)/src_infection.c$(ObjectSuffix) $(IntermediateDirectory)/src_infectiousAgent.c$(ObjectSuffix) $(IntermediateDirectory)/src_reservoir.c$(ObjectSuffix) $(IntermediateDirectory)/src_hash.c$(ObjectSuffix) $(IntermediateDirectory)/src_stringPool.c$(ObjectSuffix) $(IntermediateDirectory)/src_memPool.c$(ObjectSuffix) $(IntermediateDirectory)/src_citySeries.c$(ObjectSuffix) $(IntermediateDirectory)/src_writer.c$(ObjectSuffix) $(IntermediateDirectory)/src_groupBy.c$(ObjectSuffix) $(IntermediateDirectory)/src_commons.c$(ObjectSuffix) $(IntermediateDirectory)/src_registry.c$(ObjectSuffix) 
 
 
 
@@ -142,6 +144,70 @@ $(IntermediateDirectory)/src_reservoir.c$(PreprocessSuffix): src/reservoir.c
 	$(CC) $(CFLAGS) $(IncludePath) $(PreprocessOnlySwitch) $(OutputSwitch) $(IntermediateDirectory)/src_reservoir.c$(PreprocessSuffix) src/reservoir.c
 
 
+$(IntermediateDirectory)/src_hash.c$(ObjectSuffix): src/hash.c $(IntermediateDirectory)/src_hash.c$(DependSuffix)
+	$(CC) $(SourceSwitch) "/home/uoc/Documents/codelite/workspaces/UOC2019infection/UOCinfectiousAgent/src/hash.c" $(CFLAGS) $(ObjectSwitch)$(IntermediateDirectory)/src_hash.c$(ObjectSuffix) $(IncludePath)
+$(IntermediateDirectory)/src_hash.c$(DependSuffix): src/hash.c
+	@$(CC) $(CFLAGS) $(IncludePath) -MG -MP -MT$(IntermediateDirectory)/src_hash.c$(ObjectSuffix) -MF$(IntermediateDirectory)/src_hash.c$(DependSuffix) -MM src/hash.c
+
+$(IntermediateDirectory)/src_hash.c$(PreprocessSuffix): src/hash.c
+	$(CC) $(CFLAGS) $(IncludePath) $(PreprocessOnlySwitch) $(OutputSwitch) $(IntermediateDirectory)/src_hash.c$(PreprocessSuffix) src/hash.c
+
+$(IntermediateDirectory)/src_stringPool.c$(ObjectSuffix): src/stringPool.c $(IntermediateDirectory)/src_stringPool.c$(DependSuffix)
+	$(CC) $(SourceSwitch) "/home/uoc/Documents/codelite/workspaces/UOC2019infection/UOCinfectiousAgent/src/stringPool.c" $(CFLAGS) $(ObjectSwitch)$(IntermediateDirectory)/src_stringPool.c$(ObjectSuffix) $(IncludePath)
+$(IntermediateDirectory)/src_stringPool.c$(DependSuffix): src/stringPool.c
+	@$(CC) $(CFLAGS) $(IncludePath) -MG -MP -MT$(IntermediateDirectory)/src_stringPool.c$(ObjectSuffix) -MF$(IntermediateDirectory)/src_stringPool.c$(DependSuffix) -MM src/stringPool.c
+
+$(IntermediateDirectory)/src_stringPool.c$(PreprocessSuffix): src/stringPool.c
+	$(CC) $(CFLAGS) $(IncludePath) $(PreprocessOnlySwitch) $(OutputSwitch) $(IntermediateDirectory)/src_stringPool.c$(PreprocessSuffix) src/stringPool.c
+
+$(IntermediateDirectory)/src_memPool.c$(ObjectSuffix): src/memPool.c $(IntermediateDirectory)/src_memPool.c$(DependSuffix)
+	$(CC) $(SourceSwitch) "/home/uoc/Documents/codelite/workspaces/UOC2019infection/UOCinfectiousAgent/src/memPool.c" $(CFLAGS) $(ObjectSwitch)$(IntermediateDirectory)/src_memPool.c$(ObjectSuffix) $(IncludePath)
+$(IntermediateDirectory)/src_memPool.c$(DependSuffix): src/memPool.c
+	@$(CC) $(CFLAGS) $(IncludePath) -MG -MP -MT$(IntermediateDirectory)/src_memPool.c$(ObjectSuffix) -MF$(IntermediateDirectory)/src_memPool.c$(DependSuffix) -MM src/memPool.c
+
+$(IntermediateDirectory)/src_memPool.c$(PreprocessSuffix): src/memPool.c
+	$(CC) $(CFLAGS) $(IncludePath) $(PreprocessOnlySwitch) $(OutputSwitch) $(IntermediateDirectory)/src_memPool.c$(PreprocessSuffix) src/memPool.c
+
+$(IntermediateDirectory)/src_citySeries.c$(ObjectSuffix): src/citySeries.c $(IntermediateDirectory)/src_citySeries.c$(DependSuffix)
+	$(CC) $(SourceSwitch) "/home/uoc/Documents/codelite/workspaces/UOC2019infection/UOCinfectiousAgent/src/citySeries.c" $(CFLAGS) $(ObjectSwitch)$(IntermediateDirectory)/src_citySeries.c$(ObjectSuffix) $(IncludePath)
+$(IntermediateDirectory)/src_citySeries.c$(DependSuffix): src/citySeries.c
+	@$(CC) $(CFLAGS) $(IncludePath) -MG -MP -MT$(IntermediateDirectory)/src_citySeries.c$(ObjectSuffix) -MF$(IntermediateDirectory)/src_citySeries.c$(DependSuffix) -MM src/citySeries.c
+
+$(IntermediateDirectory)/src_citySeries.c$(PreprocessSuffix): src/citySeries.c
+	$(CC) $(CFLAGS) $(IncludePath) $(PreprocessOnlySwitch) $(OutputSwitch) $(IntermediateDirectory)/src_citySeries.c$(PreprocessSuffix) src/citySeries.c
+
+$(IntermediateDirectory)/src_writer.c$(ObjectSuffix): src/writer.c $(IntermediateDirectory)/src_writer.c$(DependSuffix)
+	$(CC) $(SourceSwitch) "/home/uoc/Documents/codelite/workspaces/UOC2019infection/UOCinfectiousAgent/src/writer.c" $(CFLAGS) $(ObjectSwitch)$(IntermediateDirectory)/src_writer.c$(ObjectSuffix) $(IncludePath)
+$(IntermediateDirectory)/src_writer.c$(DependSuffix): src/writer.c
+	@$(CC) $(CFLAGS) $(IncludePath) -MG -MP -MT$(IntermediateDirectory)/src_writer.c$(ObjectSuffix) -MF$(IntermediateDirectory)/src_writer.c$(DependSuffix) -MM src/writer.c
+
+$(IntermediateDirectory)/src_writer.c$(PreprocessSuffix): src/writer.c
+	$(CC) $(CFLAGS) $(IncludePath) $(PreprocessOnlySwitch) $(OutputSwitch) $(IntermediateDirectory)/src_writer.c$(PreprocessSuffix) src/writer.c
+
+$(IntermediateDirectory)/src_groupBy.c$(ObjectSuffix): src/groupBy.c $(IntermediateDirectory)/src_groupBy.c$(DependSuffix)
+	$(CC) $(SourceSwitch) "/home/uoc/Documents/codelite/workspaces/UOC2019infection/UOCinfectiousAgent/src/groupBy.c" $(CFLAGS) $(ObjectSwitch)$(IntermediateDirectory)/src_groupBy.c$(ObjectSuffix) $(IncludePath)
+$(IntermediateDirectory)/src_groupBy.c$(DependSuffix): src/groupBy.c
+	@$(CC) $(CFLAGS) $(IncludePath) -MG -MP -MT$(IntermediateDirectory)/src_groupBy.c$(ObjectSuffix) -MF$(IntermediateDirectory)/src_groupBy.c$(DependSuffix) -MM src/groupBy.c
+
+$(IntermediateDirectory)/src_groupBy.c$(PreprocessSuffix): src/groupBy.c
+	$(CC) $(CFLAGS) $(IncludePath) $(PreprocessOnlySwitch) $(OutputSwitch) $(IntermediateDirectory)/src_groupBy.c$(PreprocessSuffix) src/groupBy.c
+
+$(IntermediateDirectory)/src_commons.c$(ObjectSuffix): src/commons.c $(IntermediateDirectory)/src_commons.c$(DependSuffix)
+	$(CC) $(SourceSwitch) "/home/uoc/Documents/codelite/workspaces/UOC2019infection/UOCinfectiousAgent/src/commons.c" $(CFLAGS) $(ObjectSwitch)$(IntermediateDirectory)/src_commons.c$(ObjectSuffix) $(IncludePath)
+$(IntermediateDirectory)/src_commons.c$(DependSuffix): src/commons.c
+	@$(CC) $(CFLAGS) $(IncludePath) -MG -MP -MT$(IntermediateDirectory)/src_commons.c$(ObjectSuffix) -MF$(IntermediateDirectory)/src_commons.c$(DependSuffix) -MM src/commons.c
+
+$(IntermediateDirectory)/src_commons.c$(PreprocessSuffix): src/commons.c
+	$(CC) $(CFLAGS) $(IncludePath) $(PreprocessOnlySwitch) $(OutputSwitch) $(IntermediateDirectory)/src_commons.c$(PreprocessSuffix) src/commons.c
+
+$(IntermediateDirectory)/src_registry.c$(ObjectSuffix): src/registry.c $(IntermediateDirectory)/src_registry.c$(DependSuffix)
+	$(CC) $(SourceSwitch) "/home/uoc/Documents/codelite/workspaces/UOC2019infection/UOCinfectiousAgent/src/registry.c" $(CFLAGS) $(ObjectSwitch)$(IntermediateDirectory)/src_registry.c$(ObjectSuffix) $(IncludePath)
+$(IntermediateDirectory)/src_registry.c$(DependSuffix): src/registry.c
+	@$(CC) $(CFLAGS) $(IncludePath) -MG -MP -MT$(IntermediateDirectory)/src_registry.c$(ObjectSuffix) -MF$(IntermediateDirectory)/src_registry.c$(DependSuffix) -MM src/registry.c
+
+$(IntermediateDirectory)/src_registry.c$(PreprocessSuffix): src/registry.c
+	$(CC) $(CFLAGS) $(IncludePath) $(PreprocessOnlySwitch) $(OutputSwitch) $(IntermediateDirectory)/src_registry.c$(PreprocessSuffix) src/registry.c
+
 -include $(IntermediateDirectory)/*$(DependSuffix)
 ##
 ## Clean
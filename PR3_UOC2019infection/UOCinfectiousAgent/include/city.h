@@ -6,6 +6,13 @@
 #include <stdbool.h>
 #include <limits.h>
 #include "city.h"
+#include "hash.h"
+#include "memPool.h"
+#include "citySeries.h"
+#include "writer.h"
+
+// Lists with at least this number of cities keep a hash index of the names. Smaller lists are just scanned.
+#define CITY_LIST_INDEX_MIN_SIZE 16
 
 // Definition of a City
 typedef struct {
@@ -19,6 +26,27 @@ typedef struct {
     int medical_beds;
 } tCity;
 
+// Aggregated data of a list of cities
+typedef struct {
+    long population;
+    int cases;
+    int critical_cases;
+    int deaths;
+    int recovered;
+    int medical_beds;
+    // Number of cities with more critical cases than medical beds
+    int collapsed_cities;
+} tCityTotals;
+
+// Daily report of a city, with the new data since the last report
+typedef struct {
+    char * name;
+    tDate date;
+    int cases;
+    int critical_cases;
+    int deaths;
+    int recovered;
+} tCityReport;
 
 // Definition of the city list node
 typedef struct tCityNode {
@@ -26,9 +54,35 @@ typedef struct tCityNode {
     struct tCityNode * next;
 } tCityNode;
 
+struct tCityList;
+
+// Function called when the number of collapsed cities of a list changes, with the data given to cityList_setListener
+typedef void (*tCityListListener)(struct tCityList * cities, void * data);
+
 // Definition of the city list
-typedef struct {
+typedef struct tCityList {
     tCityNode * first;
+    // Last node of the list, to append cities without going through the list
+    tCityNode * last;
+    // Number of cities in the list, updated by all the operations that change the list
+    int size;
+    // Index from the name of a city to its node. It is only used when the list is big enough (see CITY_LIST_INDEX_MIN_SIZE), otherwise it is empty.
+    // Nodes are never moved, so the index does not change when cities are inserted or deleted in other positions.
+    tHashIndex index;
+    // Totals of all the cities of the list. They are updated with the changes made by insert, delete and update, so the cities must not be modified directly.
+    tCityTotals totals;
+    // Memory of the nodes, cities, dates and names of the list. Cities inserted one after the other are close in memory, and freeing the list releases the pool at once.
+    tMemPool pool;
+    // Function called when the number of collapsed cities changes, NULL if there is none
+    tCityListListener listener;
+    void * listenerData;
+    // Number of users of a list shared with cityList_share. Shared lists cannot be changed while there is more than one user, they are copied by cityList_unshare instead. Lists owned by the user have 0.
+    unsigned int refs;
+    // Shared copy of the cities of a list owned by the user, given by cityList_share until the list is changed. NULL if there is none
+    struct tCityList * snapshot;
+    // Shared list whose cities are used by this list until it is changed (see cityList_createCopy), NULL if the list has its own cities.
+    // Meanwhile first, last, size and index are the ones of the source, and the pool of the list is empty.
+    struct tCityList * source;
 } tCityList;
 
 // Initialize the City structure
@@ -52,15 +106,43 @@ bool cityList_delete(tCityList * cities, int index);
 // Get the city at index position
 tCity * cityList_get(tCityList * cities, int index);
 
+// Returns true if the city has more critical cases than medical beds
+bool city_collapsed(tCity * city);
+
+// Set the function called when the number of collapsed cities of the list changes. It is called at most once by each insert, delete, update, batch update or recalculation. Use NULL to remove it
+void cityList_setListener(tCityList * cities, tCityListListener listener, void * data);
+
+// Get a shared, read only, version of the list. Shared lists are returned with one more user. For lists owned by the user, a shared copy is made the first time,
+// and the same copy is returned until the list is changed, so many shares of a list that does not change cost a single copy
+tCityList * cityList_share(tCityList * cities);
+
+// Get a version of a shared list that can be changed. If other users share the list, a copy is returned and the list is given back
+tCityList * cityList_unshare(tCityList * cities);
+
+// Give back a shared list. It is freed when nobody else uses it
+void cityList_release(tCityList * cities);
+
+// Create a list with the same cities (and history) as another one. The cities are shared until one of the lists is changed, so the copy is O(1).
+// The copy is changed with the usual functions: the first change gives it its own cities. The cities got from a copy must not be modified directly
+tError cityList_createCopy(tCityList * cities, tCityList * source);
+
 // Returns true if the list is empty
 bool cityList_empty(tCityList * cities);
 
 // Find cities by name
 tCity * cityList_find(tCityList * cities, char * cityName);
 
-// Update the city data
+// Update the city data. The update is also added to the history of the city. Returns NULL if the city is not in the list, or if there is no memory for its history
 tCity * cityList_update(tCityList * cities, char * cityName, tDate * date, int cases, int critical_cases, int deaths, int recovered);
 
+// Update the data of many cities, applying the reports in order. The result of each report is stored in status (OK, ERR_NOT_FOUND if the city is not in the list, or ERR_MEMORY_ERROR if it could not be added to the history of the city), if it is not NULL.
+// Returns the number of reports applied
+int cityList_updateBatch(tCityList * cities, tCityReport * reports, int count, tError * status);
+
+// Get the updates of a city with a date between from and to (both included), in the order they were made. At most max updates are stored in entries.
+// Returns the number of updates in the range, that can be bigger than max, or -1 if the city is not in the list
+int cityList_history(tCityList * cities, char * cityName, tDate * from, tDate * to, tCitySeriesEntry * entries, int max);
+
 // Delete all cities
 void cityList_free(tCityList * cities);
 
@@ -70,6 +152,15 @@ int cityList_size(tCityList * cities);
 // print the city list in console
 void cityList_print(tCityList * cities) ;
 
+// Write the city list to a writer, with the same format as cityList_print
+void cityList_write(tCityList * cities, tWriter * writer);
+
+// Get all the totals of the list. They are kept updated, so the list is not traversed.
+tCityTotals cityList_totals(tCityList * cities);
+
+// Calculate again all the totals of the list by going through all the items on the list once. Needed only if the cities were modified directly.
+tCityTotals cityList_recalculateTotals(tCityList * cities);
+
 // Calculate the total population by going through all the items on the list.
 long cityList_populationIterative(tCityNode * cityNode);
 
@@ -0,0 +1,66 @@
+#ifndef __CITY_SERIES_H__
+#define __CITY_SERIES_H__
+
+#include <stdbool.h>
+#include "error.h"
+#include "commons.h"
+#include "memPool.h"
+
+// A checkpoint is kept every this number of entries, so a range of dates can be decoded without starting from the first entry
+#define CITY_SERIES_CHECKPOINT 32
+
+// Data of a city reported on a day: the new cases, critical cases, deaths and recovered since the previous report
+typedef struct {
+    tDate date;
+    int cases;
+    int critical_cases;
+    int deaths;
+    int recovered;
+} tCitySeriesEntry;
+
+// Position of an entry in the encoded data, with the day of the entry before it
+typedef struct {
+    unsigned int offset;
+    int prevDay;
+} tCitySeriesCheckpoint;
+
+// Append only series of the daily reports of a city, encoded in a compact way.
+// Each entry starts with a byte that tells which fields are not 0, and whether the date is the day after the previous entry.
+// The date (as the difference with the previous entry) and the fields that are not 0 follow it as variable length integers, so a day without changes takes a single byte.
+// The memory of the series comes from a tMemPool, given by the owner of the series.
+typedef struct {
+    // Encoded entries
+    unsigned char * data;
+    unsigned int size;
+    unsigned int capacity;
+    // Number of entries
+    unsigned int count;
+    // Day of the last entry, as the number of days since 1/1/1970
+    int lastDay;
+    // True while the dates of the entries never go back. Only sorted series use the checkpoints to find a range of dates
+    bool sorted;
+    // Checkpoint of the entries 0, CITY_SERIES_CHECKPOINT, 2 * CITY_SERIES_CHECKPOINT...
+    tCitySeriesCheckpoint * checkpoints;
+    unsigned int checkpointsCapacity;
+} tCitySeries;
+
+// Initialize an empty series
+void citySeries_init(tCitySeries * series);
+
+// Add an entry after the last one, using memory of the pool
+tError citySeries_append(tCitySeries * series, tMemPool * pool, tCitySeriesEntry * entry);
+
+// Initialize a series with a copy of the entries of another one, using memory of the pool
+tError citySeries_copy(tCitySeries * series, tMemPool * pool, tCitySeries * source);
+
+// Give back the memory of the series to the pool
+void citySeries_free(tCitySeries * series, tMemPool * pool);
+
+// Get the number of entries of the series
+unsigned int citySeries_size(tCitySeries * series);
+
+// Get the entries with a date between from and to (both included), in the order they were added. At most max entries are stored in entries.
+// Returns the number of entries in the range, that can be bigger than max
+int citySeries_range(tCitySeries * series, tDate * from, tDate * to, tCitySeriesEntry * entries, int max);
+
+#endif // __CITY_SERIES_H__
@@ -1,6 +1,9 @@
 #ifndef __COMMONS_H__
 #define __COMMONS_H__
 
+#include <stddef.h>
+#include "error.h"
+
 // Definition of a Date data type
 typedef struct {
     int day;
@@ -8,4 +11,23 @@ typedef struct {
     int year;
 } tDate;
 
+// Definition of the ways to fill the gap left by an element removed from a table
+typedef enum {
+    REMOVE_SHIFT,   // Move all the following elements one position. The order of the table is kept
+    REMOVE_SWAP,    // Move the last element to the gap. It is O(1), but the order of the table changes
+    REMOVE_TOMBSTONE // Leave the removed element in its position, marked as removed. It is O(1) and no element is moved. The gaps are removed when there are too many of them
+} tRemoveMode;
+
+// Get the capacity of a dynamic array to hold at least count elements. The capacity (minCapacity for an empty array) is doubled until they fit.
+// All the dynamic arrays of the library grow geometrically with this function: instead of one element at a time, so adding n elements costs O(n) and only needs O(log n) reallocations.
+// Removing elements never reduces the capacity, so the memory can be used by the next elements added.
+unsigned int array_capacity(unsigned int capacity, unsigned int count, unsigned int minCapacity);
+
+// Change the size of a dynamic array, given the address of its pointer, to capacity elements of elementSize bytes.
+// If there is no memory, ERR_MEMORY_ERROR is returned and the array is not changed: realloc keeps the previous block on error, so no element is lost.
+tError array_resize(void* array, unsigned int capacity, size_t elementSize);
+
+// Make room in a dynamic array, given the address of its pointer and its capacity, for at least count elements of elementSize bytes. See array_capacity and array_resize
+tError array_reserve(void* array, unsigned int* capacity, unsigned int count, size_t elementSize, unsigned int minCapacity);
+
 #endif // __COMMONS_H__
\ No newline at end of file
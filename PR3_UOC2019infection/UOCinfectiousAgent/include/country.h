@@ -4,41 +4,67 @@
 #include "error.h"
 #include "city.h"
 
+// Default number of collapsed cities (see city_collapsed) from which a country is in health collapse
+#define COUNTRY_COLLAPSE_THRESHOLD 1
+
+struct tCountry;
+
+// Function called when a country enters or leaves health collapse, with the data given to country_setCollapseCallback
+typedef void (*tCollapseCallback)(struct tCountry * country, void * data);
+
 // Definition of a country
-typedef struct {
+typedef struct tCountry {
     char * name;
+    // True while the number of collapsed cities is at least collapse_threshold. It is updated each time the list of cities changes
     bool health_collapse;
+    int collapse_threshold;
+    // Cities of the country. Each country has its own list, but copies of a country use the same cities (see cityList_createCopy) until one of them is changed
     tCityList * cities;
+    // Function called when health_collapse changes, NULL if there is none
+    tCollapseCallback onCollapse;
+    void * collapseData;
 } tCountry;
 
 // Initialize the Country structure
 tError country_init(tCountry * country, char * name);
 
-// Copy the data of a Country to another Country
+// Copy the data of a Country to another Country. The cities are shared, so the copy is O(1) until one of the countries changes them
 tError country_cpy(tCountry * dest, tCountry * src);
 
 // Add new City to Country
 tError country_addCity(tCountry * country, tCity * city);
 
+// Update the data of many cities of the Country. See cityList_updateBatch
+int country_updateBatch(tCountry * country, tCityReport * reports, int count, tError * status);
+
+// Set the number of collapsed cities from which the country is in health collapse
+void country_setCollapseThreshold(tCountry * country, int threshold);
+
+// Set the function called when the country enters or leaves health collapse. Use NULL to remove it
+void country_setCollapseCallback(tCountry * country, tCollapseCallback callback, void * data);
+
 // Compare two Countries
 bool country_equal(tCountry * country1, tCountry * country2);
 
 // Remove the memory used by tCountry structure
 tError country_free(tCountry * country);
 
-// Calculate the total population by going through all the items on the list.
+// Get all the totals of the country. They are kept updated by the list of cities, so it is O(1).
+tCityTotals country_totals(tCountry * country);
+
+// Get the total population of the country.
 long country_totalPopulation(tCountry * country);
 
-// Calculate the total cases by going through all the items on the list.
+// Get the total cases of the country.
 int country_totalCases(tCountry * country);
 
-// Calculate the total Critical Cases by going through all the items on the list.
+// Get the total Critical Cases of the country.
 int country_totalCriticalCases(tCountry * country);
 
-// Calculate the total deaths by going through all the items on the list.
+// Get the total deaths of the country.
 int country_totalDeaths(tCountry * country);
 
-// Calculate the total Recovered by going through all the items on the list.
+// Get the total Recovered of the country.
 int country_totalRecovered(tCountry * country);
 
 
@@ -0,0 +1,75 @@
+#ifndef __GROUP_BY_H__
+#define __GROUP_BY_H__
+
+#include <stdbool.h>
+#include "error.h"
+#include "infection.h"
+#include "hash.h"
+
+// Initial number of groups that fit in a result
+#define GROUP_RESULT_MIN_CAPACITY 8
+
+// Field used to group the infections of a table
+typedef enum {
+    GROUP_BY_AGENT,     // One group for each infectious agent
+    GROUP_BY_COUNTRY    // One group for each country
+} tGroupKey;
+
+// Aggregates that can be calculated for each group. They are flags, so a set of aggregates is built with |
+typedef enum {
+    AGGREGATE_COUNT = 1,                // Number of infections of the group
+    AGGREGATE_CASES = 2,                // Sum of the cases
+    AGGREGATE_DEATHS = 4,               // Sum of the deaths
+    AGGREGATE_CRITICAL_CASES = 8,       // Sum of the critical cases
+    AGGREGATE_RECOVERED = 16,           // Sum of the recovered
+    AGGREGATE_MORTALITY_RATE = 32,      // Deaths divided by cases, like infectionTable_getMortalityRate
+    AGGREGATE_CRITICAL_RATIO = 64,      // Critical cases divided by cases
+    AGGREGATE_MAX_INFECTION = 128,      // Infection with most cases, like infectionTable_getMaxInfection
+    AGGREGATE_ALL = 255
+} tAggregate;
+
+// Aggregates of a group of infections. The fields of the aggregates that were not requested are 0 (or NULL)
+typedef struct {
+    // Name of the infectious agent or the country of the group. It points to the first infection of the group, so it is valid while the table is not modified
+    const char* name;
+    unsigned int count;
+    long cases;
+    long deaths;
+    long criticalCases;
+    long recovered;
+    float mortalityRate;
+    float criticalRatio;
+    // It points to the table, so it is valid while the table is not modified
+    tInfection* maxInfection;
+} tGroupRow;
+
+// Result of a group by: one row for each group, in the order of their first infection on the table
+typedef struct {
+    tGroupKey key;
+    // Set of tAggregate flags calculated for each group
+    unsigned int aggregates;
+    unsigned int size;
+    unsigned int capacity;
+    tGroupRow* rows;
+    // Index from the name of a group to its row plus 1, so that no row is stored as NULL
+    tHashIndex index;
+} tGroupResult;
+
+// Initialize an empty result
+void groupResult_init(tGroupResult* result);
+
+// Remove the memory used by a result
+void groupResult_free(tGroupResult* result);
+
+// Get the number of groups of a result
+unsigned int groupResult_size(tGroupResult* result);
+
+// Get the row of a group by name, NULL if there is no such group
+tGroupRow* groupResult_find(tGroupResult* result, const char* name);
+
+// Calculate a set of aggregates for all the infectious agents, or all the countries, of a table with a single pass over the infections.
+// The table is split in the given number of partitions, which are aggregated independently and then merged. When the library is built with OpenMP (see OpenMPSwitch in the makefiles), each partition runs on its own thread; otherwise they run one after the other.
+// The previous content of the result is replaced.
+tError infectionTable_groupBy(tInfectionTable* table, tGroupKey key, unsigned int aggregates, unsigned int partitions, tGroupResult* result);
+
+#endif // __GROUP_BY_H__
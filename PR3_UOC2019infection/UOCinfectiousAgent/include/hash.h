@@ -0,0 +1,45 @@
+#ifndef __HASH_H__
+#define __HASH_H__
+
+#include <stdbool.h>
+#include "error.h"
+
+// Definition of an entry of the hash index. A NULL key marks an empty slot
+typedef struct {
+    const char* key;        // Key of the entry. The string is not copied, its owner must keep it alive while it is indexed
+    unsigned long hash;     // Hash value of the key, stored to avoid recomputing it when the index grows
+    void* value;            // Data associated to the key
+} tHashEntry;
+
+// Hash index from strings to data, using open addressing with linear probing
+typedef struct {
+    unsigned int size;      // Number of keys stored in the index
+    unsigned int capacity;  // Number of slots. It is always 0 or a power of 2
+    tHashEntry* entries;
+} tHashIndex;
+
+// Compute the hash value of a string
+unsigned long hash_string(const char* str);
+
+// Initialize an empty hash index
+void hashIndex_init(tHashIndex* index);
+
+// Remove the memory used by the hash index
+void hashIndex_free(tHashIndex* index);
+
+// Remove all the keys of the index, keeping its memory
+void hashIndex_clear(tHashIndex* index);
+
+// Make room for at least count keys without growing again
+tError hashIndex_reserve(tHashIndex* index, unsigned int count);
+
+// Add a key to the index. If the key already exists, its value is replaced
+tError hashIndex_put(tHashIndex* index, const char* key, void* value);
+
+// Get the value associated to a key, NULL if the key is not in the index
+void* hashIndex_get(tHashIndex* index, const char* key);
+
+// Remove a key from the index. Returns false if the key was not in the index
+bool hashIndex_remove(tHashIndex* index, const char* key);
+
+#endif // __HASH_H__
@@ -5,6 +5,13 @@
 #include "error.h"
 #include "infectiousAgent.h"
 #include "country.h"
+#include "hash.h"
+#include "commons.h"
+
+// Initial number of infections that fit in the ranking of an infectious agent
+#define INFECTION_RANKING_MIN_CAPACITY 4
+
+struct tAgentInfections;
 
 // Definition of an infection
 typedef struct {
@@ -15,23 +22,69 @@ typedef struct {
     int totalCriticalCases;
     int totalDeaths;
     int totalRecovered;
+    // True if the infection is a handle: the infectious agent and the country are borrowed from their owner instead of copied (see infection_initHandle)
+    bool borrowed;
+    // Infections of the same infectious agent in the table that contains this infection, NULL if it is not in a table. Updating the infection also updates their rollups.
+    struct tAgentInfections* agent;
 } tInfection;
 
+// Entry of the ranking of the infections of an agent: the position of an infection in the table and its totals, so entries can be compared without reading the infection
+typedef struct {
+    const char* country;    // Name of the country of the infection, which is its key in the index of countries
+    unsigned int pos;
+    int cases;
+    int deaths;
+} tInfectionRank;
+
+// Infections of one infectious agent in a table of infections, used by the index of the table
+typedef struct tAgentInfections {
+    // Name of the infectious agent. It is a copy, because the infections of the agent can be removed in any order
+    char* name;
+    // Index from the name of a country to the slot of its infection in the ranking plus 1, so that no infection is stored as NULL
+    tHashIndex countries;
+    // Max-heap of the infections of the agent, by cases, then deaths, and then position in the table. The first one is the max infection.
+    tInfectionRank* ranking;
+    unsigned int size;
+    unsigned int capacity;
+    // Running sums of the infections of the agent, to get its mortality rate without reading them
+    long totalCases;
+    long totalDeaths;
+} tAgentInfections;
+
 // Table of infections
 typedef struct {
+    // Number of used positions of the elements array. With REMOVE_TOMBSTONE, it includes the removed infections still in the array (see removed)
     unsigned int size;
+
+    // Number of elements that fit in the allocated memory block. It grows geometrically, so adding n elements only needs O(log n) reallocations.
+    unsigned int capacity;
     
     // Using static memory, the elements is an array of a fixed length MAX_ELEMENTS. That means that we are using the same amount of memory when the table is empty and when is full. We cannot add more elements than MAX_ELEMENTS.
     // tInfection elemets[MAX_ELEMENTS];
     
     // Using dynamic memory, the elements is a pointer to a region of memory. Initially, we have no memory (NULL), and we need to allocate memory when we want to add elements. We can add as many elements as we want, the only limit is the total amount of memory of our computer.
     tInfection* elements;
+
+    // Index of the infections by (infectious agent, country). It is a two level index: from the name of an agent to its tAgentInfections, and then from the name of a country to the position of the infection.
+    tHashIndex agents;
+
+    // How the gap left by a removed infection is filled. By default the order of the table is kept (REMOVE_SHIFT).
+    tRemoveMode removeMode;
+
+    // Number of removed infections still in the array (tombstones). They have a NULL infectious agent, and are skipped by all the operations of the table.
+    unsigned int removed;
     
 } tInfectionTable;
 
 // Initialize the Infection structure
 tError infection_init(tInfection* object, tInfectiousAgent* infectiousAgent, tCountry* country,  tDate* date);
 
+// Initialize the Infection structure as a handle. The infectious agent and the country are not copied, the infection points to them,
+// so they must be kept alive (and at the same address) by their owner while the infection exists. Only the date is allocated.
+// Borrow them from a tRegistry (see registry.h), which never moves them. Tables of infectious agents move their elements when they grow or remove agents, so their elements must not be borrowed.
+// Adding a handle to a table or copying it gives another handle to the same infectious agent and country.
+tError infection_initHandle(tInfection* object, tInfectiousAgent* infectiousAgent, tCountry* country, tDate* date);
+
 // Remove the memory used by Infection structure
 void infection_free(tInfection* object);
 
@@ -68,6 +121,12 @@ tError infection_cpy(tInfection* dest, tInfection* src);
 // Remove a Infection from the table
 tError infectionTable_remove(tInfectionTable* table, tInfection* Infection);
 
+// Set how the gap left by a removed infection is filled. Leaving REMOVE_TOMBSTONE compacts the table
+tError infectionTable_setRemoveMode(tInfectionTable* table, tRemoveMode mode);
+
+// Remove the infections marked as removed from the array, moving the others to fill the gaps. The order of the table is kept
+tError infectionTable_compact(tInfectionTable* table);
+
 // Given an infectious agent and a table of type tInfectionTable, 
 // it performs a search of the country with the largest infected population, 
 // offering us a pointer to it. In case of a tie, the country that is first on the list will be returned. 
@@ -2,29 +2,91 @@
 #define __INFECTIOUS_AGENT_H__
 
 #include <stdbool.h>
+#include <limits.h>
 #include "error.h"
 #include "commons.h"
 #include "reservoir.h"
+#include "hash.h"
+#include "writer.h"
+
+// Tables with at least this number of infectious agents keep a hash index of the names. Smaller tables are just scanned.
+#define INFECTIOUS_AGENT_TABLE_INDEX_MIN_SIZE 8
+
+// Id of no agent, used to end the list of free ids of a table of infectious agents
+#define INFECTIOUS_AGENT_NO_ID UINT_MAX
 
 // Definition of a infectious agent
+// The date is stored in the structure, so scanning agents by date does not follow a pointer. The strings are stored together in a single block of memory that starts with the name. The fields point to their position in the block.
 typedef struct {
-    char* name;     // Name of the infectious agent. It is a unique identifier
+    char* name;     // Name of the infectious agent. It is a unique identifier and the start of the block of memory
     float r0;       // Basic reproductive ratio R0
     char* medium;   // Transmission medium
-    tDate* date;    // Date of first infection
+    tDate date;     // Date of first infection
     char* city;     // City of first infection
     tReservoirTable* reservoirList; // Infectious agent reservoir list
 } tInfectiousAgent;
 
+// Reference to a reservoir of an infectious agent, used by the index of species
+typedef struct {
+    const char* agent;      // Name of the infectious agent
+    const char* reservoir;  // Name of the reservoir
+} tSpeciesRef;
+
+// Entry of the index of species: all the reservoirs of a species in a table of infectious agents
+typedef struct {
+    const char* species;
+    unsigned int size;
+    unsigned int capacity;
+    tSpeciesRef* refs;
+} tSpeciesEntry;
+
+// Entry of the index of R0: the position of an agent in the table and its R0, so entries can be compared without reading the agent
+typedef struct {
+    float r0;
+    unsigned int pos;
+} tR0Entry;
+
 // Table of infectious agents
 typedef struct {
+    // Number of used positions of the elements array. With REMOVE_TOMBSTONE, it includes the removed agents still in the array (see removed)
     unsigned int size;
+
+    // Number of elements that fit in the allocated memory block. It grows geometrically, so adding n elements only needs O(log n) reallocations.
+    unsigned int capacity;
     
     // Using static memory, the elements is an array of a fixed length MAX_ELEMENTS. That means that we are using the same amount of memory when the table is empty and when is full. We cannot add more elements than MAX_ELEMENTS.
     // tReservoir elemets[MAX_ELEMENTS];
     
     // Using dynamic memory, the elements is a pointer to a region of memory. Initially, we have no memory (NULL), and we need to allocate memory when we want to add elements. We can add as many elements as we want, the only limit is the total amount of memory of our computer.
     tInfectiousAgent* elements;
+
+    // Index from the name of an infectious agent to its id plus 1, so that no id is stored as NULL. It is only used when the table is big enough (see INFECTIOUS_AGENT_TABLE_INDEX_MIN_SIZE), otherwise it is empty.
+    tHashIndex index;
+
+    // Each agent of the table has an id that does not change while it is in the table. ids[pos] is the id of the agent at a position, and positions[id] is the position of the agent with an id.
+    // The index of names stores ids, so moving agents inside the table only updates these arrays, and the index is not changed. Both arrays have room for capacity entries.
+    unsigned int* ids;
+    unsigned int* positions;
+    // Number of ids given to agents. The ids of the removed agents are reused: the first one is freeId, and positions[id] of a free id is the next free one
+    unsigned int idCount;
+    unsigned int freeId;
+
+    // How the gap left by a removed infectious agent is filled. By default the order of the table is kept (REMOVE_SHIFT).
+    tRemoveMode removeMode;
+
+    // Number of removed agents still in the array (tombstones). They have a NULL name, and are skipped by all the operations of the table.
+    unsigned int removed;
+
+    // Index of the agents sorted by R0 (and by position for equal R0). It has room for capacity entries, so adding an agent never allocates memory for it.
+    // While it is valid, it is updated by add and remove. Operations that move many agents just mark it as not valid, and it is sorted again by the next query.
+    tR0Entry* r0Index;
+    unsigned int r0IndexSize;
+    bool r0IndexValid;
+
+    // Inverted index from the species of the reservoirs to the infectious agents that have them (tSpeciesEntry)
+    tHashIndex species;
+    // indexedReservoirs[id] is the shared list of reservoirs indexed for the agent with an id. The agent can change its list (see infectiousAgent_getMutableReservoirs), so the entries of the index are removed using this list, not the current one.
+    tReservoirTable** indexedReservoirs;
     
 } tInfectiousAgentTable;
 
@@ -34,13 +96,31 @@ tError infectiousAgent_init(tInfectiousAgent* object, char* name, float r0, char
 // Remove the memory used by infectious agent structure
 void infectiousAgent_free(tInfectiousAgent* object);
 
-// Get the reservoirs list of an infectious agent
+// Get the name of an infectious agent
+const char* infectiousAgent_getName(tInfectiousAgent* object);
+
+// Get the basic reproductive ratio R0 of an infectious agent
+float infectiousAgent_getR0(tInfectiousAgent* object);
+
+// Get the transmission medium of an infectious agent
+const char* infectiousAgent_getMedium(tInfectiousAgent* object);
+
+// Get the date of first infection of an infectious agent
+tDate infectiousAgent_getDate(tInfectiousAgent* object);
+
+// Get the city of first infection of an infectious agent
+const char* infectiousAgent_getCity(tInfectiousAgent* object);
+
+// Get the reservoirs list of an infectious agent. The list can be shared with other agents, so it must not be modified
 tReservoirTable* infectiousAgent_getReservoirs(tInfectiousAgent* object);
 
+// Get the reservoirs list of an infectious agent to modify it. If the list is shared, the agent gets its own copy
+tReservoirTable* infectiousAgent_getMutableReservoirs(tInfectiousAgent* object);
+
 // Compare two infectious agent
 bool infectiousAgent_equals(tInfectiousAgent* infectiousAgent1, tInfectiousAgent* infectiousAgent2);
 
-// Copy the data of a infectious agent to another infectious agent
+// Copy the data of a infectious agent to another infectious agent. The destination must be initialized or empty (all its fields NULL, as infectiousAgent_free leaves it), and its previous data is freed
 tError infectiousAgent_cpy(tInfectiousAgent* dest, tInfectiousAgent* src);
 
 // Initialize the Table of infectious agents
@@ -49,20 +129,48 @@ void infectiousAgentTable_init(tInfectiousAgentTable* table);
 // Remove the memory used by reservoirTable structure
 void infectiousAgentTable_free(tInfectiousAgentTable* object);
 
+// Make room in the table for at least count infectious agents
+tError infectiousAgentTable_reserve(tInfectiousAgentTable* table, unsigned int count);
+
 // Add a new infectious agent to the table
 tError infectiousAgentTable_add(tInfectiousAgentTable* table, tInfectiousAgent* infectiousAgent);
 
+// Add an array of infectious agents to the table. Agents already in the table or repeated in the array are skipped
+tError infectiousAgentTable_addBulk(tInfectiousAgentTable* table, tInfectiousAgent* infectiousAgents, unsigned int count);
+
 // Remove a infectious agent from the table
 tError infectiousAgentTable_remove(tInfectiousAgentTable* table, tInfectiousAgent* infectiousAgent);
 
+// Set how the gap left by a removed infectious agent is filled. Leaving REMOVE_TOMBSTONE compacts the table
+tError infectiousAgentTable_setRemoveMode(tInfectiousAgentTable* table, tRemoveMode mode);
+
+// Remove the agents marked as removed from the array, moving the others to fill the gaps. The order of the table is kept
+tError infectiousAgentTable_compact(tInfectiousAgentTable* table);
+
 // Get infectious agent by infectious agent name
 tInfectiousAgent* infectiousAgentTable_find(tInfectiousAgentTable* table, const char* infectiousAgentName);
 
 // Get the size of the table
 unsigned int infectiousAgentTable_size(tInfectiousAgentTable* table);
 
+// Get the reservoirs of a species and their infectious agents, NULL if no agent of the table has a reservoir of the species
+// The reservoirs of each agent are the ones it had when it was added or when infectiousAgentTable_updateSpecies was called
+tSpeciesEntry* infectiousAgentTable_findBySpecies(tInfectiousAgentTable* table, const char* species);
+
+// Index again the species of an infectious agent of the table, after its reservoirs have been changed
+tError infectiousAgentTable_updateSpecies(tInfectiousAgentTable* table, const char* infectiousAgentName);
+
+// Get the infectious agents with R0 between minR0 and maxR0 (both included), sorted by R0. At most maxResults agents are stored in result. Returns the number of agents stored
+unsigned int infectiousAgentTable_findByR0(tInfectiousAgentTable* table, float minR0, float maxR0, tInfectiousAgent** result, unsigned int maxResults);
+
+// Get the k infectious agents with the highest R0, from the highest to the lowest. Returns the number of agents stored in result
+unsigned int infectiousAgentTable_topR0(tInfectiousAgentTable* table, unsigned int k, tInfectiousAgent** result);
+
 // print the table in the console
 void infectiousAgentTable_print(tInfectiousAgentTable * table);
 
+// Write the table to a writer, with the same format as infectiousAgentTable_print
+void infectiousAgentTable_write(tInfectiousAgentTable * table, tWriter * writer);
+
 
 #endif // __INFECTIOUS_AGENT_H__
\ No newline at end of file
@@ -0,0 +1,48 @@
+#ifndef __MEM_POOL_H__
+#define __MEM_POOL_H__
+
+#include <stddef.h>
+
+// Size of the blocks of memory requested to the system by a pool
+#define MEM_POOL_CHUNK_SIZE 8192
+
+// All the sizes are rounded up to a multiple of this value, so every allocation is aligned for any data type
+#define MEM_POOL_ALIGN 16
+
+// Number of size classes with a list of free blocks. Allocations up to MEM_POOL_CLASSES * MEM_POOL_ALIGN bytes are reused when they are freed
+#define MEM_POOL_CLASSES 16
+
+// Number of size classes for bigger allocations. Their sizes are rounded up to a power of two, from 2 * MEM_POOL_CLASSES * MEM_POOL_ALIGN bytes (512) up to 2 GB
+#define MEM_POOL_BIG_CLASSES 23
+
+// Block of memory requested to the system. The allocations are taken from the memory that follows it
+typedef struct tMemPoolChunk {
+    struct tMemPoolChunk * next;
+} tMemPoolChunk;
+
+// Pool of memory. Allocations are taken one after the other from big chunks, so data allocated together is close in memory.
+// All the memory of the pool is given back to the system at once with memPool_release.
+typedef struct {
+    // Chunks requested to the system
+    tMemPoolChunk * chunks;
+    // Next free byte of the current chunk, and number of bytes left in it
+    char * top;
+    size_t available;
+    // Blocks given back to the pool, by size class: first the classes of MEM_POOL_ALIGN bytes, then the power of two ones. Each free block stores the address of the next one
+    void * freeBlocks[MEM_POOL_CLASSES + MEM_POOL_BIG_CLASSES];
+} tMemPool;
+
+// Initialize an empty pool
+void memPool_init(tMemPool * pool);
+
+// Allocate size bytes from the pool. Returns NULL if there is no memory
+void * memPool_alloc(tMemPool * pool, size_t size);
+
+// Give back a block of size bytes to the pool, to be reused by the next allocations of the same size class.
+// Blocks bigger than the last power of two class are only given back to the system by memPool_release
+void memPool_free(tMemPool * pool, void * ptr, size_t size);
+
+// Give back all the memory of the pool to the system. All the blocks allocated from the pool are freed
+void memPool_release(tMemPool * pool);
+
+#endif // __MEM_POOL_H__
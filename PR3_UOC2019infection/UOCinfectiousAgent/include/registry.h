@@ -0,0 +1,63 @@
+#ifndef __REGISTRY_H__
+#define __REGISTRY_H__
+
+#include <stddef.h>
+#include "error.h"
+#include "infectiousAgent.h"
+#include "country.h"
+#include "hash.h"
+
+// Number of elements of each chunk of a slot array
+#define REGISTRY_CHUNK_SIZE 64
+
+// Array of elements of the same size, stored in chunks of REGISTRY_CHUNK_SIZE elements. Growing only adds chunks, and the chunks are not moved or freed until the array is freed, so the address of an element never changes.
+typedef struct {
+    size_t elementSize;
+    // Pointers to the chunks. Only this array is moved when more chunks are needed
+    char** chunks;
+    unsigned int chunkCount;
+    unsigned int chunkCapacity;
+    // Number of slots used, including the free ones
+    unsigned int size;
+    // Slots of the removed elements, which are reused by the next elements added
+    unsigned int* freeSlots;
+    unsigned int freeCount;
+    unsigned int freeCapacity;
+} tSlotArray;
+
+// Central registry of infectious agents and countries, which handle infections borrow instead of copying them (see infection_initHandle).
+// The registry keeps its own copies, and they stay at the same address while other agents and countries are added or removed.
+typedef struct {
+    tSlotArray agents;
+    // Index from the name of an infectious agent to its copy in the registry
+    tHashIndex agentIndex;
+    tSlotArray countries;
+    // Index from the name of a country to its copy in the registry
+    tHashIndex countryIndex;
+} tRegistry;
+
+// Initialize an empty registry
+void registry_init(tRegistry* registry);
+
+// Remove the memory used by the registry. The handles that borrow its agents and countries must be freed before
+void registry_free(tRegistry* registry);
+
+// Add a copy of an infectious agent to the registry. Returns ERR_DUPLICATED if there is already an agent with the same name
+tError registry_addAgent(tRegistry* registry, tInfectiousAgent* infectiousAgent);
+
+// Get the copy of an infectious agent in the registry, NULL if it is not in the registry. The address is valid until the agent is removed
+tInfectiousAgent* registry_findAgent(tRegistry* registry, const char* infectiousAgentName);
+
+// Remove an infectious agent from the registry. No handle can borrow it anymore
+tError registry_removeAgent(tRegistry* registry, const char* infectiousAgentName);
+
+// Add a copy of a country to the registry. Returns ERR_DUPLICATED if there is already a country with the same name
+tError registry_addCountry(tRegistry* registry, tCountry* country);
+
+// Get the copy of a country in the registry, NULL if it is not in the registry. The address is valid until the country is removed
+tCountry* registry_findCountry(tRegistry* registry, const char* countryName);
+
+// Remove a country from the registry. No handle can borrow it anymore
+tError registry_removeCountry(tRegistry* registry, const char* countryName);
+
+#endif // __REGISTRY_H__
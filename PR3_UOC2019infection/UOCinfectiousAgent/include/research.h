@@ -3,6 +3,7 @@
 
 #include "infection.h"
 #include "commons.h"
+#include "writer.h"
 
 typedef struct {
     unsigned int Infectivity;
@@ -73,4 +74,7 @@ tError researchList_bubbleSort(tResearchList *list);
 // Helper function, print list contents
 void researchList_print(tResearchList list);
 
+// Write the list contents to a writer, with the same format as researchList_print
+void researchList_write(tResearchList* list, tWriter* writer);
+
 #endif // __RESEARCH_H__
@@ -3,6 +3,12 @@
 
 #include <stdbool.h>
 #include "error.h"
+#include "commons.h"
+#include "hash.h"
+#include "writer.h"
+
+// Tables with at least this number of reservoirs keep a hash index of the names. Smaller tables are just scanned.
+#define RESERVOIR_TABLE_INDEX_MIN_SIZE 8
 
 // Definition of a reservoir
 typedef struct {
@@ -11,14 +17,29 @@ typedef struct {
 } tReservoir;
 
 // Table of reservoirs
-typedef struct {
+typedef struct tReservoirTable {
     unsigned int size;
+
+    // Number of elements that fit in the allocated memory block. It grows geometrically, so adding n elements only needs O(log n) reallocations.
+    unsigned int capacity;
     
     // Using static memory, the elements is an array of a fixed length MAX_ELEMENTS. That means that we are using the same amount of memory when the table is empty and when is full. We cannot add more elements than MAX_ELEMENTS.
     // tReservoir elemets[MAX_ELEMENTS];
     
     // Using dynamic memory, the elements is a pointer to a region of memory. Initially, we have no memory (NULL), and we need to allocate memory when we want to add elements. We can add as many elements as we want, the only limit is the total amount of memory of our computer.
     tReservoir* elements;
+
+    // Index from the name of a reservoir to its element. It is only used when the table is big enough (see RESERVOIR_TABLE_INDEX_MIN_SIZE), otherwise it is empty.
+    tHashIndex index;
+
+    // How the gap left by a removed reservoir is filled. By default the order of the table is kept (REMOVE_SHIFT).
+    tRemoveMode removeMode;
+
+    // Number of infectious agents sharing the table. Tables shared by agents are allocated with reservoirTable_share and cannot be modified, they are copied when an agent needs to change them. Tables owned by the user have 0.
+    unsigned int refs;
+
+    // Shared copy of a table owned by the user, made the first time it is shared. Later agents initialized with the same table use this copy instead of making a new one. It is given back when the table changes or is freed. Shared tables have NULL.
+    struct tReservoirTable* shared;
     
 } tReservoirTable;
 
@@ -46,16 +67,40 @@ void reservoirTable_free(tReservoirTable* object);
 // Add a new reservoir to the table
 tError reservoirTable_add(tReservoirTable* table, tReservoir* reservoir);
 
+// Make room in the table for at least count reservoirs
+tError reservoirTable_reserve(tReservoirTable* table, unsigned int count);
+
+// Add an array of reservoirs to the table. Reservoirs already in the table or repeated in the array are skipped
+tError reservoirTable_addBulk(tReservoirTable* table, tReservoir* reservoirs, unsigned int count);
+
 // Remove a reservoir from the table
 tError reservoirTable_remove(tReservoirTable* table, tReservoir* reservoir);
 
+// Remove an array of reservoirs from the table in a single pass. Returns ERR_NOT_FOUND if some of them were not in the table
+tError reservoirTable_removeMany(tReservoirTable* table, tReservoir* reservoirs, unsigned int count);
+
+// Set how the gap left by a removed reservoir is filled
+void reservoirTable_setRemoveMode(tReservoirTable* table, tRemoveMode mode);
+
 // Get reservoir by reservoirname
 tReservoir* reservoirTable_find(tReservoirTable* table, const char* reservoirname);
 
 // Get the size of the table
 unsigned int reservoirTable_size(tReservoirTable* table);
 
+// Get a shared, read only, version of the table. Shared tables are returned with one more user. Tables owned by the user are copied only once, until they change
+tReservoirTable* reservoirTable_share(tReservoirTable* table);
+
+// Get a version of a shared table that can be modified. If other users share the table, a copy is returned and the table is given back
+tReservoirTable* reservoirTable_unshare(tReservoirTable* table);
+
+// Give back a shared table. It is freed when nobody else uses it
+void reservoirTable_release(tReservoirTable* table);
+
 // print the table in the console
 void reservoirTable_print(tReservoirTable * table);
 
+// Write the table to a writer, with the same format as reservoirTable_print
+void reservoirTable_write(tReservoirTable * table, tWriter * writer);
+
 #endif // __reservoir__H__
\ No newline at end of file
@@ -0,0 +1,17 @@
+#ifndef __STRING_POOL_H__
+#define __STRING_POOL_H__
+
+// Pool of shared strings. Equal strings added to the pool share the same memory, so they can be compared by their address.
+// Each string is released when the last user gives it back to the pool.
+// The pool is global and not thread-safe: strings must not be added or released from parallel code, such as the partitions of groupBy.
+
+// Get the shared copy of a string, adding it to the pool if needed. Returns NULL if there is no memory
+const char* stringPool_intern(const char* str);
+
+// Give back a shared string. It is freed when nobody else uses it
+void stringPool_release(const char* str);
+
+// Get the number of different strings in the pool
+unsigned int stringPool_size();
+
+#endif // __STRING_POOL_H__
@@ -0,0 +1,65 @@
+#ifndef __WRITER_H__
+#define __WRITER_H__
+
+#include <stdio.h>
+#include <stdbool.h>
+#include "error.h"
+
+// Size of the buffer of writers to files. The text is written to the file when the buffer is full
+#define WRITER_BUFFER_SIZE 65536
+
+// Where the text of a writer goes
+typedef enum {
+    WRITER_FILE,    // A FILE*, such as stdout
+    WRITER_FD,      // A file descriptor
+    WRITER_MEMORY   // A buffer in memory that grows as needed
+} tWriterTarget;
+
+// Writer of reports. The text is added to a buffer, and written with a single call when the buffer is full.
+// Numbers are formatted directly into the buffer instead of using printf.
+typedef struct {
+    tWriterTarget target;
+    FILE * file;
+    int fd;
+    // Text not written yet. For memory writers, all the text written
+    char * buffer;
+    unsigned int size;
+    unsigned int capacity;
+    // First error found, OK if there is none. Once there is an error, the rest of the text is discarded
+    tError error;
+} tWriter;
+
+// Initialize a writer to a FILE*
+tError writer_initFile(tWriter * writer, FILE * file);
+
+// Initialize a writer to a file descriptor
+tError writer_initFd(tWriter * writer, int fd);
+
+// Initialize a writer to memory
+void writer_initMemory(tWriter * writer);
+
+// Add a string
+void writer_putString(tWriter * writer, const char * str);
+
+// Add a char
+void writer_putChar(tWriter * writer, char c);
+
+// Add an integer in base 10
+void writer_putLong(tWriter * writer, long value);
+
+// Add an unsigned integer in base 10
+void writer_putULong(tWriter * writer, unsigned long value);
+
+// Write the text in the buffer to the file. It does nothing for memory writers
+tError writer_flush(tWriter * writer);
+
+// Get the text of a memory writer, ended with '\0'. It is valid until the next change of the writer
+const char * writer_data(tWriter * writer);
+
+// Get the first error found by the writer
+tError writer_error(tWriter * writer);
+
+// Write the pending text and remove the memory used by the writer. Returns the first error found by the writer
+tError writer_free(tWriter * writer);
+
+#endif // __WRITER_H__
@@ -2,6 +2,7 @@
 #include <stdlib.h>
 #include <assert.h>
 #include <string.h>
+#include <stddef.h>
 #include "city.h"
 #include <stdbool.h>
 #include <limits.h>
@@ -83,6 +84,103 @@ bool city_equal(tCity * city1, tCity * city2){
 
 }
 
+// Returns true if the city has more critical cases than medical beds
+bool city_collapsed(tCity * city){
+    // Verify pre conditions
+    assert(city != NULL);
+
+    return city->critical_cases > city->medical_beds;
+}
+
+// Set all the totals to 0
+static void cityTotals_init(tCityTotals * totals)
+{
+	totals->population = 0;
+	totals->cases = 0;
+	totals->critical_cases = 0;
+	totals->deaths = 0;
+	totals->recovered = 0;
+	totals->medical_beds = 0;
+	totals->collapsed_cities = 0;
+}
+
+// Add (sign 1) or subtract (sign -1) the data of a city to the totals
+static void cityTotals_apply(tCityTotals * totals, tCity * city, int sign)
+{
+	totals->population += sign * city->population;
+	totals->cases += sign * city->cases;
+	totals->critical_cases += sign * city->critical_cases;
+	totals->deaths += sign * city->deaths;
+	totals->recovered += sign * city->recovered;
+	totals->medical_beds += sign * city->medical_beds;
+	totals->collapsed_cities += city_collapsed(city) ? sign : 0;
+}
+
+// Call the listener of the list if the number of collapsed cities is not the same as before a change
+static void cityList_notify(tCityList * cities, int collapsed)
+{
+	if (cities->listener != NULL && cities->totals.collapsed_cities != collapsed) {
+		cities->listener(cities, cities->listenerData);
+	}
+}
+
+// Node of a list of cities, allocated from the pool of the list in a single block with its city, date and history
+typedef struct {
+    tCityNode node;
+    tCity city;
+    tDate last_update;
+    tCitySeries series;
+} tCityRecord;
+
+// Get the record of a city of a list
+static tCityRecord * cityList_record(tCity * city)
+{
+	return (tCityRecord*)((char*)city - offsetof(tCityRecord, city));
+}
+
+// Create a node with a copy of a city, using the memory of the pool of the list
+static tCityNode * cityList_newNode(tCityList * cities, tCity * city)
+{
+	tCityRecord * record;
+	size_t length;
+
+	record = (tCityRecord*)memPool_alloc(&cities->pool, sizeof(tCityRecord));
+	if (record == NULL) {
+		return NULL;
+	}
+	length = strlen(city->name) + 1;
+	record->city.name = (char*)memPool_alloc(&cities->pool, length * sizeof(char));
+	if (record->city.name == NULL) {
+		memPool_free(&cities->pool, record, sizeof(tCityRecord));
+		return NULL;
+	}
+
+	memcpy(record->city.name, city->name, length * sizeof(char));
+	record->last_update = *city->last_update;
+	record->city.last_update = &record->last_update;
+	record->city.population = city->population;
+	record->city.cases = city->cases;
+	record->city.critical_cases = city->critical_cases;
+	record->city.deaths = city->deaths;
+	record->city.recovered = city->recovered;
+	record->city.medical_beds = city->medical_beds;
+	record->node.city = &record->city;
+	record->node.next = NULL;
+	// The history starts when the city is inserted in the list
+	citySeries_init(&record->series);
+
+	return &record->node;
+}
+
+// Give back the memory of a node and its city to the pool of the list
+static void cityList_freeNode(tCityList * cities, tCityNode * node)
+{
+	citySeries_free(&cityList_record(node->city)->series, &cities->pool);
+	memPool_free(&cities->pool, node->city->name, (strlen(node->city->name) + 1) * sizeof(char));
+	// The node is the first field of its record
+	memPool_free(&cities->pool, node, sizeof(tCityRecord));
+}
+
 // Create a list of cities
 void cityList_create(tCityList *cities)
 {
@@ -90,6 +188,98 @@ void cityList_create(tCityList *cities)
 	assert(cities != NULL);
 
 	cities->first = NULL;
+	cities->last = NULL;
+	cities->size = 0;
+	// Small lists have no index
+	hashIndex_init(&cities->index);
+	// The totals of an empty list are 0
+	cityTotals_init(&cities->totals);
+	// No memory is allocated until the first city is inserted
+	memPool_init(&cities->pool);
+	cities->listener = NULL;
+	cities->listenerData = NULL;
+	// The list is owned by the user, not shared
+	cities->refs = 0;
+	cities->snapshot = NULL;
+	cities->source = NULL;
+}
+
+// Drop the shared copy of a list, which is not valid anymore once the list changes
+static void cityList_dropSnapshot(tCityList * cities)
+{
+	assert(cities->refs <= 1);
+
+	if (cities->snapshot != NULL) {
+		cityList_release(cities->snapshot);
+		cities->snapshot = NULL;
+	}
+}
+
+// Use the cities of the source of a list, without copying them
+static void cityList_viewSource(tCityList * cities)
+{
+	cities->first = cities->source->first;
+	cities->last = cities->source->last;
+	cities->size = cities->source->size;
+	cities->index = cities->source->index;
+}
+
+static tError cityList_copyCities(tCityList * cities, tCityList * source);
+
+// Prepare a list to be changed. Shared lists can only be changed by their only user, and the shared copy of a list is not valid anymore.
+// A list that still uses the cities of its source gets its own copy of them
+static tError cityList_changing(tCityList * cities)
+{
+	tCityList * source;
+	tError err;
+
+	cityList_dropSnapshot(cities);
+
+	if (cities->source != NULL) {
+		source = cities->source;
+		cities->first = NULL;
+		cities->last = NULL;
+		cities->size = 0;
+		hashIndex_init(&cities->index);
+		err = cityList_copyCities(cities, source);
+		if (err != OK) {
+			// Go back to the cities of the source
+			hashIndex_free(&cities->index);
+			memPool_release(&cities->pool);
+			cityList_viewSource(cities);
+			return err;
+		}
+		cities->source = NULL;
+		cityList_release(source);
+	}
+
+	return OK;
+}
+
+// Set the function called when the number of collapsed cities of the list changes
+void cityList_setListener(tCityList * cities, tCityListListener listener, void * data)
+{
+	// Verify pre conditions
+	assert(cities != NULL);
+
+	cities->listener = listener;
+	cities->listenerData = data;
+}
+
+// Build the hash index of the names with all the cities of the list
+static tError cityList_buildIndex(tCityList * cities)
+{
+	tCityNode * ptr;
+	tError err;
+
+	err = hashIndex_reserve(&cities->index, cities->size);
+	ptr = cities->first;
+	while (ptr != NULL && err == OK) {
+		err = hashIndex_put(&cities->index, ptr->city->name, ptr);
+		ptr = ptr->next;
+	}
+
+	return err;
 }
 
 // Insert a city at index position
@@ -98,6 +288,7 @@ tError cityList_insert(tCityList *cities, tCity *city, int index)
 	tCityNode * prev;
 	tCityNode * newCity;
     int i = 0;
+    int collapsed;
 
 	// Verify pre conditions
 	assert(cities != NULL);
@@ -109,36 +300,38 @@ tError cityList_insert(tCityList *cities, tCity *city, int index)
 		return ERR_DUPLICATED;
 	}
 
+	// The city can be inserted at any position, or just after the last one
+	if (index > cities->size) {
+		return ERR_INVALID;
+	}
+
+	if (cityList_changing(cities) != OK) {
+		return ERR_MEMORY_ERROR;
+	}
+
 	// Create new city
-	newCity = (tCityNode*) malloc(sizeof(tCityNode));
+	newCity = cityList_newNode(cities, city);
 	// Check that memory has been allocated
 	if (newCity == NULL){
 		return ERR_MEMORY_ERROR;
 	}
 	else{
-		newCity->city = (tCity*) malloc(sizeof(tCity));
-		// Check that memory has been allocated
-		if (newCity->city == NULL)
-		{
-            free(newCity);
-			return ERR_MEMORY_ERROR;
-		}
-		city_init(newCity->city, city->name, city->last_update, city->population, city->cases, 
-				  city->critical_cases, city->deaths, city->recovered, city->medical_beds);
-
 		if (index == 0)	{
 			// no previous element
 			newCity->next = cities->first;
 			cities->first = newCity;
+			if (cities->last == NULL) {
+				// The list was empty, the new city is also the last one
+				cities->last = newCity;
+			}
+		}
+		else if (index == cities->size) {
+			// append after the last element, without going through the list
+			newCity->next = NULL;
+			cities->last->next = newCity;
+			cities->last = newCity;
 		}
 		else{
-            if (index > cityList_size(cities)) {
-				city_free(newCity->city);
-				free(newCity->city);
-				free(newCity);			
-                return ERR_INVALID;
-			}
-                
 			// move prev to index -1 position
 			prev = cities->first;
 			while (i < index -1 && prev->next != NULL)	{
@@ -146,17 +339,21 @@ tError cityList_insert(tCityList *cities, tCity *city, int index)
 				i++;
 			}
 
-			if (prev != NULL){
-				// standard case 
-				newCity->next = prev->next;
-				prev->next = newCity;
-			}
-			else{
-				city_free(newCity->city);
-				free(newCity->city);
-				free(newCity);		
-				return ERR_INVALID;
-			}
+			// standard case 
+			newCity->next = prev->next;
+			prev->next = newCity;
+		}
+		cities->size++;
+		collapsed = cities->totals.collapsed_cities;
+		cityTotals_apply(&cities->totals, newCity->city, 1);
+		cityList_notify(cities, collapsed);
+
+		// Add the name to the index, building it when the list becomes big enough
+		if (cities->index.entries != NULL) {
+			return hashIndex_put(&cities->index, newCity->city->name, newCity);
+		}
+		else if (cities->size >= CITY_LIST_INDEX_MIN_SIZE) {
+			return cityList_buildIndex(cities);
 		}
 	}
 
@@ -165,8 +362,8 @@ tError cityList_insert(tCityList *cities, tCity *city, int index)
 
 // Delete the city at index position
 bool cityList_delete(tCityList * cities, int index) {
-    int num_elements;
     int i;
+    int collapsed;
     tCityNode * ptr;
     tCityNode * ptr_del;
 
@@ -175,40 +372,47 @@ bool cityList_delete(tCityList * cities, int index) {
     assert(index >= 0);
 
     // Out of range
-    num_elements = cityList_size(cities);
-    if (num_elements == 0 || index > num_elements) return false;
+    if (index >= cities->size) return false;
 
-    // Find element at index-1 position
-    i = 0;
-    ptr = cities->first;
-    while (i < index - 1) {
-        ptr = ptr->next;
-        i++;
-    }
-    // Now ptr points to element at index-1 position    
+    if (cityList_changing(cities) != OK) return false;
 
-    // ptr_del points to element to be deleted
     if (index == 0){
-        ptr_del = ptr;
+        // ptr_del points to element to be deleted, there is no previous element
+        ptr = NULL;
+        ptr_del = cities->first;
         cities->first = ptr_del->next;
     }
     else {
+        // Find element at index-1 position
+        i = 0;
+        ptr = cities->first;
+        while (i < index - 1) {
+            ptr = ptr->next;
+            i++;
+        }
+        // Now ptr points to element at index-1 position, and ptr_del points to element to be deleted
         ptr_del = ptr->next;
-    }
 
-
-    // Element at index-1 position points to element at index+1 position
-    if (ptr_del != NULL){
+        // Element at index-1 position points to element at index+1 position
         ptr->next = ptr_del->next;
     }
-    else {
-        ptr->next = NULL;
+
+    // If the last element is deleted, the previous one is the new last element (NULL if the list is now empty)
+    if (ptr_del == cities->last) {
+        cities->last = ptr;
+    }
+    cities->size--;
+    collapsed = cities->totals.collapsed_cities;
+    cityTotals_apply(&cities->totals, ptr_del->city, -1);
+    cityList_notify(cities, collapsed);
+
+    // Remove the name from the index while the string is still allocated
+    if (cities->index.entries != NULL) {
+        hashIndex_remove(&cities->index, ptr_del->city->name);
     }
 
     // Delete element
-    city_free(ptr_del->city);
-    free(ptr_del->city);
-    free(ptr_del);
+    cityList_freeNode(cities, ptr_del);
 
 
     return true;
@@ -216,7 +420,6 @@ bool cityList_delete(tCityList * cities, int index) {
 
 // Get the city at index position
 tCity * cityList_get(tCityList * cities, int index) {
-    int num_elements;
     int i;
     tCityNode * ptr;
 
@@ -225,8 +428,10 @@ tCity * cityList_get(tCityList * cities, int index) {
     assert(index >= 0);
 
     // Out of range
-    num_elements = cityList_size(cities);
-    if (num_elements == 0 || index > num_elements) return NULL;
+    if (index >= cities->size) return NULL;
+
+    // The last element is directly available
+    if (index == cities->size - 1) return cities->last->city;
 
     // Find element at index position
     i = 0;
@@ -241,6 +446,147 @@ tCity * cityList_get(tCityList * cities, int index) {
     else return NULL;
 }
 
+// Append a copy of all the cities of source, with their history, to an empty list. The totals are not changed
+static tError cityList_copyCities(tCityList * cities, tCityList * source)
+{
+    tCityNode * ptr;
+    tCityNode * node;
+
+    // The cities are appended, so each one is O(1)
+    for (ptr = source->first; ptr != NULL; ptr = ptr->next) {
+        node = cityList_newNode(cities, ptr->city);
+        if (node == NULL) {
+            return ERR_MEMORY_ERROR;
+        }
+        if (citySeries_copy(&cityList_record(node->city)->series, &cities->pool, &cityList_record(ptr->city)->series) != OK) {
+            cityList_freeNode(cities, node);
+            return ERR_MEMORY_ERROR;
+        }
+        if (cities->last == NULL) {
+            cities->first = node;
+        }
+        else {
+            cities->last->next = node;
+        }
+        cities->last = node;
+        cities->size++;
+    }
+
+    if (cities->size >= CITY_LIST_INDEX_MIN_SIZE) {
+        return cityList_buildIndex(cities);
+    }
+
+    return OK;
+}
+
+// Make a shared copy of a list, with one user
+static tCityList * cityList_clone(tCityList * cities)
+{
+    tCityList * shared;
+
+    shared = (tCityList*)malloc(sizeof(tCityList));
+    if (shared == NULL) {
+        return NULL;
+    }
+    cityList_create(shared);
+    if (cityList_copyCities(shared, cities) != OK) {
+        cityList_free(shared);
+        free(shared);
+        return NULL;
+    }
+    shared->totals = cities->totals;
+    shared->refs = 1;
+
+    return shared;
+}
+
+// Get a shared, read only, version of the list
+tCityList * cityList_share(tCityList * cities)
+{
+    // Verify pre conditions
+    assert(cities != NULL);
+
+    // The list is already shared, just count one more user
+    if (cities->refs > 0) {
+        cities->refs++;
+        return cities;
+    }
+
+    // The list still uses the cities of a shared list, which can be shared too
+    if (cities->source != NULL) {
+        cities->source->refs++;
+        return cities->source;
+    }
+
+    // The list is owned by the user, who could change it. Make a copy that will be shared until the list changes. The list keeps a reference to it.
+    if (cities->snapshot == NULL) {
+        cities->snapshot = cityList_clone(cities);
+        if (cities->snapshot == NULL) {
+            return NULL;
+        }
+    }
+    cities->snapshot->refs++;
+
+    return cities->snapshot;
+}
+
+// Get a version of a shared list that can be changed
+tCityList * cityList_unshare(tCityList * cities)
+{
+    tCityList * copy;
+
+    // Verify pre conditions
+    assert(cities != NULL);
+    assert(cities->refs > 0);
+
+    // We are the only user, so the list can be changed
+    if (cities->refs == 1) {
+        return cities;
+    }
+
+    copy = cityList_clone(cities);
+    if (copy != NULL) {
+        cityList_release(cities);
+    }
+
+    return copy;
+}
+
+// Give back a shared list. It is freed when nobody else uses it
+void cityList_release(tCityList * cities)
+{
+    // Verify pre conditions
+    assert(cities != NULL);
+    assert(cities->refs > 0);
+
+    cities->refs--;
+    if (cities->refs == 0) {
+        cityList_free(cities);
+        free(cities);
+    }
+}
+
+// Create a list with the same cities as another one, shared until one of them is changed
+tError cityList_createCopy(tCityList * cities, tCityList * source)
+{
+    tCityList * shared;
+
+    // Verify pre conditions
+    assert(cities != NULL);
+    assert(source != NULL);
+
+    cityList_create(cities);
+    shared = cityList_share(source);
+    if (shared == NULL) {
+        return ERR_MEMORY_ERROR;
+    }
+    cities->source = shared;
+    cityList_viewSource(cities);
+    cities->totals = shared->totals;
+
+    return OK;
+}
+
 // Returns true if the list is empty
 bool cityList_empty(tCityList * cities) {
     // Verify pre conditions
@@ -252,7 +598,6 @@ bool cityList_empty(tCityList * cities) {
 
 // Find cities by name
 tCity * cityList_find(tCityList * cities, char * cityName) {
-    int num_elements;
     tCityNode * ptr;
     bool findCity = false;
 
@@ -260,9 +605,14 @@ tCity * cityList_find(tCityList * cities, char * cityName) {
     assert(cities != NULL);
     assert(cityName != NULL);
 
-    // Out of range
-    num_elements = cityList_size(cities);
-    if (num_elements == 0) return NULL;
+    // Empty list
+    if (cities->size == 0) return NULL;
+
+    // Big lists have an index of names
+    if (cities->index.entries != NULL) {
+        ptr = (tCityNode*)hashIndex_get(&cities->index, cityName);
+        return (ptr != NULL) ? ptr->city : NULL;
+    }
 
     // Find element with city-name = cityName
     ptr = cities->first;
@@ -280,9 +630,58 @@ tCity * cityList_find(tCityList * cities, char * cityName) {
     else return NULL;
 }
 
+// Apply the data of a report to a city of the list and add it to its history, and add the changes to deltas
+static tError cityList_applyUpdate(tCityList * cities, tCity * city, tDate * date, int cases, int critical_cases, int deaths, int recovered, tCityTotals * deltas) {
+    tCitySeriesEntry entry;
+    tError err;
+
+    // Add the report to the history first, so the city is not changed if there is no memory
+    entry.date = *date;
+    entry.cases = cases;
+    entry.critical_cases = critical_cases;
+    entry.deaths = deaths;
+    entry.recovered = recovered;
+    err = citySeries_append(&cityList_record(city)->series, &cities->pool, &entry);
+    if (err != OK) {
+        return err;
+    }
+
+    deltas->collapsed_cities -= city_collapsed(city) ? 1 : 0;
+
+    city->last_update->day = date->day;
+    city->last_update->month = date->month;
+    city->last_update->year = date->year;
+    city->cases += cases;
+    city->critical_cases += critical_cases;
+    city->deaths += deaths;
+    city->recovered += recovered;
+    city->population -= deaths;
+
+    deltas->cases += cases;
+    deltas->critical_cases += critical_cases;
+    deltas->deaths += deaths;
+    deltas->recovered += recovered;
+    deltas->population -= deaths;
+    deltas->collapsed_cities += city_collapsed(city) ? 1 : 0;
+
+    return OK;
+}
+
+// Add the changes of some updates to the totals of the list
+static void cityList_applyDeltas(tCityList * cities, tCityTotals * deltas) {
+    cities->totals.cases += deltas->cases;
+    cities->totals.critical_cases += deltas->critical_cases;
+    cities->totals.deaths += deltas->deaths;
+    cities->totals.recovered += deltas->recovered;
+    cities->totals.population += deltas->population;
+    cities->totals.collapsed_cities += deltas->collapsed_cities;
+    cityList_notify(cities, cities->totals.collapsed_cities - deltas->collapsed_cities);
+}
+
 // Update the city data
 tCity * cityList_update(tCityList * cities, char * cityName, tDate * date, int cases, int critical_cases, int deaths, int recovered) {
     tCity * city;
+    tCityTotals deltas = { 0 };
 
     // Verify pre conditions
     assert(cities != NULL);
@@ -299,78 +698,219 @@ tCity * cityList_update(tCityList * cities, char * cityName, tDate * date, int c
     if (city == NULL)
         return NULL;
 
+    if (cityList_changing(cities) != OK)
+        return NULL;
 
-    city->last_update->day = date->day;
-    city->last_update->month = date->month;
-    city->last_update->year = date->year;
-    city->cases += cases;
-    city->critical_cases += critical_cases;
-    city->deaths += deaths;
-    city->recovered += recovered;
-    city->population -= deaths;
+    // The list could have got its own cities
+    city = cityList_find(cities, cityName);
+
+    if (cityList_applyUpdate(cities, city, date, cases, critical_cases, deaths, recovered, &deltas) != OK)
+        return NULL;
+
+    // Apply the same changes to the totals of the list
+    cityList_applyDeltas(cities, &deltas);
 
     return city;
 }
 
-// Delete all cities
-void cityList_free(tCityList * cities) {
-    tCityNode * ptrCity;
-    tCityNode * ptrDeleteCity;
+// Update the data of many cities, applying the reports in order
+int cityList_updateBatch(tCityList * cities, tCityReport * reports, int count, tError * status) {
+    tCity * city;
+    tCityTotals deltas = { 0 };
+    tError err;
+    int applied = 0;
+    int first, i;
+
+    // Verify pre conditions
+    assert(cities != NULL);
+    assert(reports != NULL || count == 0);
+    assert(count >= 0);
+
+    // Find the first report of a city of the list. The list is only prepared to change if some report will be applied, so a batch without cities of the list does not copy shared cities
+    for (first = 0; first < count; first++) {
+        assert(reports[first].name != NULL);
+        if (cityList_find(cities, reports[first].name) != NULL) {
+            break;
+        }
+        if (status != NULL) status[first] = ERR_NOT_FOUND;
+    }
+    if (first == count) {
+        return 0;
+    }
+
+    if (cityList_changing(cities) != OK) {
+        // The list still has the same cities, so the reports of the cities that are not in the list are still not found
+        for (i = first; i < count && status != NULL; i++) {
+            status[i] = (cityList_find(cities, reports[i].name) != NULL) ? ERR_MEMORY_ERROR : ERR_NOT_FOUND;
+        }
+        return 0;
+    }
+
+    for (i = first; i < count; i++) {
+        assert(reports[i].name != NULL);
+        assert(reports[i].cases >= 0);
+        assert(reports[i].critical_cases >= 0);
+        assert(reports[i].deaths >= 0);
+        assert(reports[i].recovered >= 0);
+
+        // Big lists find each city with their index of names
+        city = cityList_find(cities, reports[i].name);
+        if (city == NULL) {
+            if (status != NULL) status[i] = ERR_NOT_FOUND;
+            continue;
+        }
+
+        err = cityList_applyUpdate(cities, city, &reports[i].date, reports[i].cases, reports[i].critical_cases, reports[i].deaths, reports[i].recovered, &deltas);
+        if (status != NULL) status[i] = err;
+        if (err == OK) applied++;
+    }
+
+    // The totals of the list are changed once, with the changes of all the reports
+    cityList_applyDeltas(cities, &deltas);
+
+    return applied;
+}
+
+// Get the updates of a city with a date between from and to
+int cityList_history(tCityList * cities, char * cityName, tDate * from, tDate * to, tCitySeriesEntry * entries, int max) {
+    tCity * city;
 
     // Verify pre conditions
     assert(cities != NULL);
+    assert(cityName != NULL);
+
+    city = cityList_find(cities, cityName);
+    if (city == NULL)
+        return -1;
 
-    ptrCity = cities->first;
+    return citySeries_range(&cityList_record(city)->series, from, to, entries, max);
+}
 
-    while (ptrCity != NULL) {
-        ptrDeleteCity = ptrCity;
-        ptrCity = ptrCity->next;
+// Delete all cities
+void cityList_free(tCityList * cities) {
+    int collapsed;
 
-        city_free(ptrDeleteCity->city);
-        free(ptrDeleteCity->city);
-        free(ptrDeleteCity);
+    // Verify pre conditions
+    assert(cities != NULL);
+    cityList_dropSnapshot(cities);
 
+    // A list that uses the cities of its source just gives them back. Its index is the one of the source
+    if (cities->source != NULL) {
+        cityList_release(cities->source);
+        cities->source = NULL;
+        hashIndex_init(&cities->index);
+    }
+    else {
+        hashIndex_free(&cities->index);
     }
-    //free(ptr);
+
+    // All the nodes, cities and names come from the pool, so they are freed at once without going through the list
+    memPool_release(&cities->pool);
     cities->first = NULL;
+    cities->last = NULL;
+    cities->size = 0;
+    collapsed = cities->totals.collapsed_cities;
+    cityTotals_init(&cities->totals);
+    cityList_notify(cities, collapsed);
 }
 
 // Gets the number of elements in the list
 int cityList_size(tCityList * cities) {
-    int num_elements = 0;
-    tCityNode * ptr;
+    // Verify pre conditions
+    assert(cities != NULL);
 
-    ptr = cities->first;
+    // The size is updated each time a city is inserted or deleted, so there is no need to go through the list
+    return cities->size;
+}
 
-    while (ptr != NULL) {
-        num_elements++;
-        ptr = ptr->next;
-    }
+// print the city list in console
+void cityList_print(tCityList * cities) {
+    tWriter writer;
 
-    return num_elements;
+    // Verify pre conditions
+    assert(cities != NULL);
+
+    writer_initFile(&writer, stdout);
+    cityList_write(cities, &writer);
+    writer_free(&writer);
 }
 
-// Create a list of cities
-void cityList_print(tCityList * cities) {
+// Write the city list to a writer
+void cityList_write(tCityList * cities, tWriter * writer) {
     // Verify pre conditions
     assert(cities != NULL);
+    assert(writer != NULL);
     int num_elements = 0;
     tCityNode * ptr;
     ptr = cities->first;
     while (ptr != NULL) {
-        printf("%d %s \n ", num_elements, ptr->city->name);
-        printf("\tpopulation:%li medical_beds:%d updated:%d/%d/%d \n ",
-            ptr->city->population,
-            ptr->city->medical_beds,
-            ptr->city->last_update->day,
-            ptr->city->last_update->month,
-            ptr->city->last_update->year);
-        printf("\tcases:%d critical:%d deaths:%d recovered:%d \n ", ptr->city->cases, ptr->city->critical_cases, ptr->city->deaths, ptr->city->recovered);
+        writer_putLong(writer, num_elements);
+        writer_putChar(writer, ' ');
+        writer_putString(writer, ptr->city->name);
+        writer_putString(writer, " \n \tpopulation:");
+        writer_putLong(writer, ptr->city->population);
+        writer_putString(writer, " medical_beds:");
+        writer_putLong(writer, ptr->city->medical_beds);
+        writer_putString(writer, " updated:");
+        writer_putLong(writer, ptr->city->last_update->day);
+        writer_putChar(writer, '/');
+        writer_putLong(writer, ptr->city->last_update->month);
+        writer_putChar(writer, '/');
+        writer_putLong(writer, ptr->city->last_update->year);
+        writer_putString(writer, " \n \tcases:");
+        writer_putLong(writer, ptr->city->cases);
+        writer_putString(writer, " critical:");
+        writer_putLong(writer, ptr->city->critical_cases);
+        writer_putString(writer, " deaths:");
+        writer_putLong(writer, ptr->city->deaths);
+        writer_putString(writer, " recovered:");
+        writer_putLong(writer, ptr->city->recovered);
+        writer_putString(writer, " \n ");
 
         ptr = ptr->next;
         num_elements++;
     }
-    printf("\n ");
+    writer_putString(writer, "\n ");
+}
+
+// Get all the totals of the list. They are kept updated, so the list is not traversed.
+tCityTotals cityList_totals(tCityList * cities){
+    // Verify pre conditions
+    assert(cities != NULL);
+
+    return cities->totals;
+}
+
+// Calculate again all the totals of the list by going through all the items on the list once. Needed only if the cities were modified directly.
+tCityTotals cityList_recalculateTotals(tCityList * cities){
+    tCityTotals totals = { 0 };
+    tCityNode * ptr;
+    int collapsed;
+
+    // Verify pre conditions
+    assert(cities != NULL);
+    // The cities were changed directly. Only the totals are changed here, so a list that uses the cities of its source keeps using them
+    cityList_dropSnapshot(cities);
+
+    // A single loop adds all the fields of each city. Each node is visited once instead of once for each total,
+    // and as there is no recursion, the stack does not grow with the size of the list.
+    ptr = cities->first;
+    while (ptr != NULL) {
+        totals.population += ptr->city->population;
+        totals.cases += ptr->city->cases;
+        totals.critical_cases += ptr->city->critical_cases;
+        totals.deaths += ptr->city->deaths;
+        totals.recovered += ptr->city->recovered;
+        totals.medical_beds += ptr->city->medical_beds;
+        totals.collapsed_cities += city_collapsed(ptr->city) ? 1 : 0;
+        ptr = ptr->next;
+    }
+
+    collapsed = cities->totals.collapsed_cities;
+    cities->totals = totals;
+    cityList_notify(cities, collapsed);
+
+    return totals;
 }
 
 long cityList_populationIterative(tCityNode * ptr){
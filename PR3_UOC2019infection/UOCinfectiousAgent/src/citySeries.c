@@ -0,0 +1,321 @@
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "citySeries.h"
+
+// Bits of the first byte of an entry
+#define CITY_SERIES_CASES          0x01
+#define CITY_SERIES_CRITICAL_CASES 0x02
+#define CITY_SERIES_DEATHS         0x04
+#define CITY_SERIES_RECOVERED      0x08
+#define CITY_SERIES_NEXT_DAY       0x10
+
+// Maximum size of an encoded entry: the first byte, the date and the 4 fields, with up to 5 bytes each
+#define CITY_SERIES_MAX_ENTRY_SIZE 26
+
+// Initial size of the encoded data of a series
+#define CITY_SERIES_MIN_CAPACITY 32
+
+// Number of days from 1/1/1970 to a date of the Gregorian calendar
+static int citySeries_dayNumber(tDate * date) {
+    int year, era, yearOfEra, dayOfYear, dayOfEra;
+    int month;
+
+    // Years start in March, so the leap day is the last day of the year
+    year = date->year - (date->month <= 2 ? 1 : 0);
+    month = date->month;
+    era = (year >= 0 ? year : year - 399) / 400;
+    yearOfEra = year - era * 400;
+    dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + date->day - 1;
+    dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+
+    return era * 146097 + dayOfEra - 719468;
+}
+
+// Date of the Gregorian calendar for a number of days from 1/1/1970
+static void citySeries_date(int dayNumber, tDate * date) {
+    int era, dayOfEra, yearOfEra, dayOfYear, monthPos;
+
+    dayNumber += 719468;
+    era = (dayNumber >= 0 ? dayNumber : dayNumber - 146096) / 146097;
+    dayOfEra = dayNumber - era * 146097;
+    yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    monthPos = (5 * dayOfYear + 2) / 153;
+
+    date->day = dayOfYear - (153 * monthPos + 2) / 5 + 1;
+    date->month = monthPos + (monthPos < 10 ? 3 : -9);
+    date->year = yearOfEra + era * 400 + (date->month <= 2 ? 1 : 0);
+}
+
+// Write an unsigned integer with 7 bits in each byte. The highest bit tells if more bytes follow
+static unsigned char * citySeries_putVarint(unsigned char * ptr, unsigned int value) {
+    while (value >= 0x80) {
+        *ptr++ = (unsigned char)(value | 0x80);
+        value >>= 7;
+    }
+    *ptr++ = (unsigned char)value;
+
+    return ptr;
+}
+
+// Read an unsigned integer written by citySeries_putVarint
+static const unsigned char * citySeries_getVarint(const unsigned char * ptr, unsigned int * value) {
+    unsigned int shift = 0;
+
+    *value = 0;
+    while (*ptr & 0x80) {
+        *value |= (unsigned int)(*ptr++ & 0x7F) << shift;
+        shift += 7;
+    }
+    *value |= (unsigned int)(*ptr++) << shift;
+
+    return ptr;
+}
+
+// Map signed integers to unsigned ones, so numbers close to 0 (positive or negative) take few bytes
+static unsigned int citySeries_zigzag(int value) {
+    return (value >= 0) ? ((unsigned int)value << 1) : (((unsigned int)(-(value + 1)) << 1) | 1);
+}
+
+// Inverse of citySeries_zigzag
+static int citySeries_unzigzag(unsigned int value) {
+    return (value & 1) ? -(int)(value >> 1) - 1 : (int)(value >> 1);
+}
+
+// Move a block of the pool to a bigger one
+static void * citySeries_grow(tMemPool * pool, void * data, size_t size, size_t newSize) {
+    void * newData;
+
+    newData = memPool_alloc(pool, newSize);
+    if (newData == NULL) {
+        return NULL;
+    }
+    if (data != NULL) {
+        memcpy(newData, data, size);
+        memPool_free(pool, data, size);
+    }
+
+    return newData;
+}
+
+// Initialize an empty series
+void citySeries_init(tCitySeries * series) {
+    // Verify pre conditions
+    assert(series != NULL);
+
+    series->data = NULL;
+    series->size = 0;
+    series->capacity = 0;
+    series->count = 0;
+    series->lastDay = 0;
+    series->sorted = true;
+    series->checkpoints = NULL;
+    series->checkpointsCapacity = 0;
+}
+
+// Add an entry after the last one
+tError citySeries_append(tCitySeries * series, tMemPool * pool, tCitySeriesEntry * entry) {
+    unsigned char * ptr;
+    unsigned char flags = 0;
+    unsigned int capacity;
+    void * data;
+    int day;
+
+    // Verify pre conditions
+    assert(series != NULL);
+    assert(pool != NULL);
+    assert(entry != NULL);
+    assert(entry->cases >= 0);
+    assert(entry->critical_cases >= 0);
+    assert(entry->deaths >= 0);
+    assert(entry->recovered >= 0);
+
+    // Make room for the entry. The memory grows geometrically
+    if (series->size + CITY_SERIES_MAX_ENTRY_SIZE > series->capacity) {
+        capacity = (series->capacity > 0) ? series->capacity : CITY_SERIES_MIN_CAPACITY;
+        while (series->size + CITY_SERIES_MAX_ENTRY_SIZE > capacity) {
+            capacity *= 2;
+        }
+        data = citySeries_grow(pool, series->data, series->size, capacity);
+        if (data == NULL) {
+            return ERR_MEMORY_ERROR;
+        }
+        series->data = (unsigned char*)data;
+        series->capacity = capacity;
+    }
+
+    // Make room for the checkpoint of the entry
+    if (series->count % CITY_SERIES_CHECKPOINT == 0 && series->count / CITY_SERIES_CHECKPOINT == series->checkpointsCapacity) {
+        capacity = (series->checkpointsCapacity > 0) ? series->checkpointsCapacity * 2 : 1;
+        data = citySeries_grow(pool, series->checkpoints, series->checkpointsCapacity * sizeof(tCitySeriesCheckpoint), capacity * sizeof(tCitySeriesCheckpoint));
+        if (data == NULL) {
+            return ERR_MEMORY_ERROR;
+        }
+        series->checkpoints = (tCitySeriesCheckpoint*)data;
+        series->checkpointsCapacity = capacity;
+    }
+    if (series->count % CITY_SERIES_CHECKPOINT == 0) {
+        series->checkpoints[series->count / CITY_SERIES_CHECKPOINT].offset = series->size;
+        series->checkpoints[series->count / CITY_SERIES_CHECKPOINT].prevDay = series->lastDay;
+    }
+
+    day = citySeries_dayNumber(&entry->date);
+    if (series->count > 0 && day < series->lastDay) {
+        series->sorted = false;
+    }
+
+    if (entry->cases != 0) flags |= CITY_SERIES_CASES;
+    if (entry->critical_cases != 0) flags |= CITY_SERIES_CRITICAL_CASES;
+    if (entry->deaths != 0) flags |= CITY_SERIES_DEATHS;
+    if (entry->recovered != 0) flags |= CITY_SERIES_RECOVERED;
+    if (series->count > 0 && day == series->lastDay + 1) flags |= CITY_SERIES_NEXT_DAY;
+
+    ptr = series->data + series->size;
+    *ptr++ = flags;
+    if (!(flags & CITY_SERIES_NEXT_DAY)) ptr = citySeries_putVarint(ptr, citySeries_zigzag(day - series->lastDay));
+    if (flags & CITY_SERIES_CASES) ptr = citySeries_putVarint(ptr, (unsigned int)entry->cases);
+    if (flags & CITY_SERIES_CRITICAL_CASES) ptr = citySeries_putVarint(ptr, (unsigned int)entry->critical_cases);
+    if (flags & CITY_SERIES_DEATHS) ptr = citySeries_putVarint(ptr, (unsigned int)entry->deaths);
+    if (flags & CITY_SERIES_RECOVERED) ptr = citySeries_putVarint(ptr, (unsigned int)entry->recovered);
+
+    series->size = (unsigned int)(ptr - series->data);
+    series->count++;
+    series->lastDay = day;
+
+    return OK;
+}
+
+// Initialize a series with a copy of the entries of another one
+tError citySeries_copy(tCitySeries * series, tMemPool * pool, tCitySeries * source) {
+    // Verify pre conditions
+    assert(series != NULL);
+    assert(pool != NULL);
+    assert(source != NULL);
+
+    // The encoded data and the checkpoints are copied as they are, with the same capacity, so they can keep growing in the new pool
+    *series = *source;
+    series->data = NULL;
+    series->checkpoints = NULL;
+    if (source->capacity > 0) {
+        series->data = (unsigned char*)memPool_alloc(pool, source->capacity);
+        if (series->data == NULL) {
+            citySeries_init(series);
+            return ERR_MEMORY_ERROR;
+        }
+        memcpy(series->data, source->data, source->size);
+    }
+    if (source->checkpointsCapacity > 0) {
+        series->checkpoints = (tCitySeriesCheckpoint*)memPool_alloc(pool, source->checkpointsCapacity * sizeof(tCitySeriesCheckpoint));
+        if (series->checkpoints == NULL) {
+            memPool_free(pool, series->data, series->capacity);
+            citySeries_init(series);
+            return ERR_MEMORY_ERROR;
+        }
+        memcpy(series->checkpoints, source->checkpoints, source->checkpointsCapacity * sizeof(tCitySeriesCheckpoint));
+    }
+
+    return OK;
+}
+
+// Give back the memory of the series to the pool
+void citySeries_free(tCitySeries * series, tMemPool * pool) {
+    // Verify pre conditions
+    assert(series != NULL);
+    assert(pool != NULL);
+
+    memPool_free(pool, series->data, series->capacity);
+    memPool_free(pool, series->checkpoints, series->checkpointsCapacity * sizeof(tCitySeriesCheckpoint));
+    citySeries_init(series);
+}
+
+// Get the number of entries of the series
+unsigned int citySeries_size(tCitySeries * series) {
+    // Verify pre conditions
+    assert(series != NULL);
+
+    return series->count;
+}
+
+// Get the entries with a date between from and to (both included)
+int citySeries_range(tCitySeries * series, tDate * from, tDate * to, tCitySeriesEntry * entries, int max) {
+    const unsigned char * ptr;
+    const unsigned char * end;
+    unsigned char flags;
+    unsigned int value;
+    unsigned int first = 0, last, middle;
+    int fromDay, toDay, day;
+    int found = 0;
+
+    // Verify pre conditions
+    assert(series != NULL);
+    assert(from != NULL);
+    assert(to != NULL);
+    assert(entries != NULL || max == 0);
+
+    if (series->count == 0) {
+        return 0;
+    }
+
+    fromDay = citySeries_dayNumber(from);
+    toDay = citySeries_dayNumber(to);
+
+    // In a sorted series, all the entries before a checkpoint are not after the day stored in it.
+    // Look for the last checkpoint whose previous entry is before the range, and decode from it
+    if (series->sorted) {
+        last = (series->count - 1) / CITY_SERIES_CHECKPOINT;
+        while (first < last) {
+            middle = (first + last + 1) / 2;
+            if (series->checkpoints[middle].prevDay < fromDay) {
+                first = middle;
+            }
+            else {
+                last = middle - 1;
+            }
+        }
+    }
+
+    ptr = series->data + series->checkpoints[first].offset;
+    day = series->checkpoints[first].prevDay;
+    end = series->data + series->size;
+    while (ptr < end) {
+        flags = *ptr++;
+        if (flags & CITY_SERIES_NEXT_DAY) {
+            day++;
+        }
+        else {
+            ptr = citySeries_getVarint(ptr, &value);
+            day += citySeries_unzigzag(value);
+        }
+
+        // Sorted series end when the range is passed
+        if (series->sorted && day > toDay) {
+            break;
+        }
+
+        if (day >= fromDay && day <= toDay && found < max) {
+            citySeries_date(day, &entries[found].date);
+            entries[found].cases = 0;
+            entries[found].critical_cases = 0;
+            entries[found].deaths = 0;
+            entries[found].recovered = 0;
+            if (flags & CITY_SERIES_CASES) { ptr = citySeries_getVarint(ptr, &value); entries[found].cases = (int)value; }
+            if (flags & CITY_SERIES_CRITICAL_CASES) { ptr = citySeries_getVarint(ptr, &value); entries[found].critical_cases = (int)value; }
+            if (flags & CITY_SERIES_DEATHS) { ptr = citySeries_getVarint(ptr, &value); entries[found].deaths = (int)value; }
+            if (flags & CITY_SERIES_RECOVERED) { ptr = citySeries_getVarint(ptr, &value); entries[found].recovered = (int)value; }
+        }
+        else {
+            // Skip the fields of the entry
+            if (flags & CITY_SERIES_CASES) ptr = citySeries_getVarint(ptr, &value);
+            if (flags & CITY_SERIES_CRITICAL_CASES) ptr = citySeries_getVarint(ptr, &value);
+            if (flags & CITY_SERIES_DEATHS) ptr = citySeries_getVarint(ptr, &value);
+            if (flags & CITY_SERIES_RECOVERED) ptr = citySeries_getVarint(ptr, &value);
+        }
+
+        if (day >= fromDay && day <= toDay) {
+            found++;
+        }
+    }
+
+    return found;
+}
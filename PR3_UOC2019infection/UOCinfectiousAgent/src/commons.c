@@ -0,0 +1,61 @@
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "commons.h"
+
+// Get the capacity of a dynamic array to hold at least count elements
+unsigned int array_capacity(unsigned int capacity, unsigned int count, unsigned int minCapacity) {
+    // Verify pre conditions
+    assert(minCapacity > 0);
+
+    if (capacity == 0) {
+        capacity = minCapacity;
+    }
+    while (capacity < count) {
+        capacity *= 2;
+    }
+
+    return capacity;
+}
+
+// Change the size of a dynamic array, given the address of its pointer
+tError array_resize(void* array, unsigned int capacity, size_t elementSize) {
+    void* elements;
+
+    // Verify pre conditions
+    assert(array != NULL);
+    assert(capacity > 0);
+
+    // The pointer of the array can have any type, so it is read and written as raw memory
+    memcpy(&elements, array, sizeof(void*));
+    elements = realloc(elements, capacity * elementSize);
+    if (elements == NULL) {
+        return ERR_MEMORY_ERROR;
+    }
+    memcpy(array, &elements, sizeof(void*));
+
+    return OK;
+}
+
+// Make room in a dynamic array for at least count elements
+tError array_reserve(void* array, unsigned int* capacity, unsigned int count, size_t elementSize, unsigned int minCapacity) {
+    unsigned int newCapacity;
+    tError err;
+
+    // Verify pre conditions
+    assert(capacity != NULL);
+
+    if (count <= *capacity) {
+        // There is already enough memory
+        return OK;
+    }
+
+    newCapacity = array_capacity(*capacity, count, minCapacity);
+    err = array_resize(array, newCapacity, elementSize);
+    if (err != OK) {
+        return err;
+    }
+    *capacity = newCapacity;
+
+    return OK;
+}
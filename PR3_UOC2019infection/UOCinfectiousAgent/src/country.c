@@ -5,6 +5,20 @@
 #include "country.h"
 #include "city.h"
 
+// Listener of the list of cities of a country. Compares the number of collapsed cities with the threshold of the country
+static void country_checkCollapse(tCityList * cities, void * data) {
+    tCountry * country = (tCountry*)data;
+    bool collapse;
+
+    collapse = cityList_totals(cities).collapsed_cities >= country->collapse_threshold;
+    if (collapse != country->health_collapse) {
+        country->health_collapse = collapse;
+        if (country->onCollapse != NULL) {
+            country->onCollapse(country, country->collapseData);
+        }
+    }
+}
+
 // Initialize the Country structure
 tError country_init(tCountry * country, char * name) {
     // Verify pre conditions
@@ -20,16 +34,24 @@ tError country_init(tCountry * country, char * name) {
 
     // Check that memory has been allocated for all fields. Pointer must be different from NULL.
     if (country->name == NULL || country->cities == NULL) {
-        // Some of the fields have a NULL value, what means that we found some problem allocating the memory
+        // Some of the fields have a NULL value, what means that we found some problem allocating the memory. Give back the other one, so the country is empty.
+        free(country->name);
+        free(country->cities);
+        country->name = NULL;
+        country->cities = NULL;
         return ERR_MEMORY_ERROR;
     }
 
     // Copy params to Country fields
     strcpy(country->name, name);
     country->health_collapse = false;
+    country->collapse_threshold = COUNTRY_COLLAPSE_THRESHOLD;
+    country->onCollapse = NULL;
+    country->collapseData = NULL;
 
-    // Create the list of cities
+    // Create the list of cities. The country is told each time the number of collapsed cities changes
     cityList_create(country->cities);
+    cityList_setListener(country->cities, country_checkCollapse, country);
 
     return OK;
 }
@@ -37,28 +59,27 @@ tError country_init(tCountry * country, char * name) {
 // Copy the data of a Country to another Country
 tError country_cpy(tCountry* dst, tCountry* src){
     tError err;
-    tCityNode* ptr = NULL;
     // Verify pre conditions   
     assert(src != NULL);
 
     // Initialize the element with the new data
+    // The destination is not freed on error: it can be a variable or part of an array (see registry_addCountry)
     err = country_init(dst, src->name);
     if (err != OK){
-        free(dst);
         return err;
     }
-    cityList_create(dst->cities);
-
-    ptr = src->cities->first;
-    while (ptr != NULL) {
-        err = country_addCity(dst, ptr->city);
-        if (err != OK){
-            free(dst);
-            return err;
-        }
-        ptr = ptr->next;
+
+    // Use the same cities as src until one of them changes, instead of copying them. The list belongs to dst, so the country is still its listener
+    cityList_free(dst->cities);
+    err = cityList_createCopy(dst->cities, src->cities);
+    cityList_setListener(dst->cities, country_checkCollapse, dst);
+    if (err != OK){
+        return err;
     }
 
+    dst->collapse_threshold = src->collapse_threshold;
+    dst->health_collapse = cityList_totals(dst->cities).collapsed_cities >= dst->collapse_threshold;
+
     return OK;
 }
 
@@ -75,6 +96,33 @@ tError country_addCity(tCountry * country, tCity * city) {
     return error;
 }
 
+// Set the number of collapsed cities from which the country is in health collapse
+void country_setCollapseThreshold(tCountry * country, int threshold) {
+    // Verify pre conditions
+    assert(country != NULL);
+    assert(threshold > 0);
+
+    country->collapse_threshold = threshold;
+    country_checkCollapse(country->cities, country);
+}
+
+// Set the function called when the country enters or leaves health collapse
+void country_setCollapseCallback(tCountry * country, tCollapseCallback callback, void * data) {
+    // Verify pre conditions
+    assert(country != NULL);
+
+    country->onCollapse = callback;
+    country->collapseData = data;
+}
+
+// Update the data of many cities of the Country
+int country_updateBatch(tCountry * country, tCityReport * reports, int count, tError * status) {
+    // Verify pre conditions
+    assert(country != NULL);
+
+    return cityList_updateBatch(country->cities, reports, count, status);
+}
+
 bool country_equal(tCountry * country1, tCountry * country2){
     // Verify pre conditions
     assert(country1 != NULL);
@@ -105,6 +153,8 @@ tError country_free(tCountry * country){
 
 
     if (country->cities != NULL) {
+        // The country is not told about the cities removed when it is freed. The list belongs to the country, even if it uses the cities of another list
+        cityList_setListener(country->cities, NULL, NULL);
         cityList_free(country->cities);
         free(country->cities);
         country->cities = NULL;
@@ -114,28 +164,36 @@ tError country_free(tCountry * country){
 }
 
 
+// Get all the totals of the country. They are kept updated by the list of cities, so it is O(1).
+tCityTotals country_totals(tCountry * country){
+    // Verify pre conditions
+    assert(country != NULL);
+
+    return cityList_totals(country->cities);
+}
+
+// Get the total population of the country.
 long country_totalPopulation(tCountry * country){
-    //return cityList_populationIterative(country->cities->first);
-    return cityList_populationRecursive(country->cities->first);
+    return country_totals(country).population;
 
 }
 
-// Calculate recursively the total  cases by going through all the items on the list.
+// Get the total cases of the country.
 int country_totalCases(tCountry * country){
-    return cityList_casesRecursive(country->cities->first);
+    return country_totals(country).cases;
 }
 
-// Calculate recursively the total critical cases by going through all the items on the list.
+// Get the total critical cases of the country.
 int country_totalCriticalCases(tCountry * country){
-    return cityList_criticalCasesRecursive(country->cities->first);
+    return country_totals(country).critical_cases;
 }
 
-// Calculate recursively the total deaths by going through all the items on the list.
+// Get the total deaths of the country.
 int country_totalDeaths(tCountry * country){
-    return cityList_deathsRecursive(country->cities->first);
+    return country_totals(country).deaths;
 }
 
-// Calculate recursively the total Recovered by going through all the items on the list.
+// Get the total Recovered of the country.
 int country_totalRecovered(tCountry * country){
-    return cityList_recoveredRecursive(country->cities->first);
+    return country_totals(country).recovered;
 }
\ No newline at end of file
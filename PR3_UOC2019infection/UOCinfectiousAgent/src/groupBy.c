@@ -0,0 +1,254 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <assert.h>
+#include "groupBy.h"
+
+// Initialize an empty result
+void groupResult_init(tGroupResult* result) {
+    // Verify pre conditions
+    assert(result != NULL);
+
+    result->key = GROUP_BY_AGENT;
+    result->aggregates = 0;
+    result->size = 0;
+    result->capacity = 0;
+    result->rows = NULL;
+    hashIndex_init(&result->index);
+}
+
+// Remove the memory used by a result
+void groupResult_free(tGroupResult* result) {
+    // Verify pre conditions
+    assert(result != NULL);
+
+    if (result->rows != NULL) {
+        free(result->rows);
+        result->rows = NULL;
+    }
+    result->size = 0;
+    result->capacity = 0;
+    hashIndex_free(&result->index);
+}
+
+// Remove all the groups of a result, keeping its memory
+static void groupResult_clear(tGroupResult* result, tGroupKey key, unsigned int aggregates) {
+    result->key = key;
+    result->aggregates = aggregates;
+    result->size = 0;
+    hashIndex_clear(&result->index);
+}
+
+// Get the number of groups of a result
+unsigned int groupResult_size(tGroupResult* result) {
+    // Verify pre conditions
+    assert(result != NULL);
+
+    return result->size;
+}
+
+// Get the row of a group by name, NULL if there is no such group
+tGroupRow* groupResult_find(tGroupResult* result, const char* name) {
+    intptr_t id;
+
+    // Verify pre conditions
+    assert(result != NULL);
+    assert(name != NULL);
+
+    id = (intptr_t)hashIndex_get(&result->index, name);
+    if (id == 0) {
+        return NULL;
+    }
+
+    return &result->rows[id - 1];
+}
+
+// Get the row of a group, adding an empty one if it is not in the result yet. Returns NULL if there is no memory for the new row
+static tGroupRow* groupResult_row(tGroupResult* result, const char* name) {
+    tGroupRow* row;
+
+    row = groupResult_find(result, name);
+    if (row != NULL) {
+        return row;
+    }
+
+    if (array_reserve(&result->rows, &result->capacity, result->size + 1, sizeof(tGroupRow), GROUP_RESULT_MIN_CAPACITY) != OK) {
+        return NULL;
+    }
+    if (hashIndex_put(&result->index, name, (void*)(intptr_t)(result->size + 1)) != OK) {
+        return NULL;
+    }
+
+    row = &result->rows[result->size];
+    memset(row, 0, sizeof(tGroupRow));
+    row->name = name;
+    result->size++;
+
+    return row;
+}
+
+// Check if an infection has more cases than another one, or the same cases and more deaths
+static bool groupBy_moreInfected(int cases1, int deaths1, int cases2, int deaths2) {
+    return cases1 > cases2 || (cases1 == cases2 && deaths1 > deaths2);
+}
+
+// Add an infection to the aggregates of its group
+static void groupBy_add(tGroupRow* row, tInfection* infection, unsigned int aggregates) {
+    row->count++;
+    row->cases += infection->totalCases;
+    row->deaths += infection->totalDeaths;
+    row->criticalCases += infection->totalCriticalCases;
+    row->recovered += infection->totalRecovered;
+
+    // Infections without cases nor deaths are never the max one. In case of tie, the first infection is kept.
+    if ((aggregates & AGGREGATE_MAX_INFECTION) && (infection->totalCases > 0 || infection->totalDeaths > 0)) {
+        if (row->maxInfection == NULL || groupBy_moreInfected(infection->totalCases, infection->totalDeaths, row->maxInfection->totalCases, row->maxInfection->totalDeaths)) {
+            row->maxInfection = infection;
+        }
+    }
+}
+
+// Merge the aggregates of a group from a later partition of the table
+static void groupBy_merge(tGroupRow* row, tGroupRow* other) {
+    row->count += other->count;
+    row->cases += other->cases;
+    row->deaths += other->deaths;
+    row->criticalCases += other->criticalCases;
+    row->recovered += other->recovered;
+
+    // The other partition comes later in the table, so it only wins if it has strictly more cases or deaths
+    if (other->maxInfection != NULL) {
+        if (row->maxInfection == NULL || groupBy_moreInfected(other->maxInfection->totalCases, other->maxInfection->totalDeaths, row->maxInfection->totalCases, row->maxInfection->totalDeaths)) {
+            row->maxInfection = other->maxInfection;
+        }
+    }
+}
+
+// Aggregate the infections in [first, last) of a table into a result
+static tError groupBy_partition(tInfectionTable* table, unsigned int first, unsigned int last, tGroupResult* result) {
+    tInfection* infection;
+    tGroupRow* row;
+    unsigned int i;
+
+    for (i = first; i < last; i++) {
+        infection = &table->elements[i];
+        // Skip the removed infections
+        if (infection->infectiousAgent == NULL) {
+            continue;
+        }
+        row = groupResult_row(result, (result->key == GROUP_BY_AGENT) ? infection->infectiousAgent->name : infection->country->name);
+        if (row == NULL) {
+            return ERR_MEMORY_ERROR;
+        }
+        groupBy_add(row, infection, result->aggregates);
+    }
+
+    return OK;
+}
+
+// Calculate the derived aggregates of all the groups, and clear the ones that were not requested
+static void groupBy_finish(tGroupResult* result) {
+    tGroupRow* row;
+    unsigned int i;
+
+    for (i = 0; i < result->size; i++) {
+        row = &result->rows[i];
+        if (result->aggregates & AGGREGATE_MORTALITY_RATE) {
+            row->mortalityRate = (float)row->deaths / (float)row->cases;
+        }
+        if (result->aggregates & AGGREGATE_CRITICAL_RATIO) {
+            row->criticalRatio = (float)row->criticalCases / (float)row->cases;
+        }
+        // The sums are cheaper to add up than to check, so they are always calculated and only cleared here
+        if (!(result->aggregates & AGGREGATE_COUNT)) {
+            row->count = 0;
+        }
+        if (!(result->aggregates & AGGREGATE_CASES)) {
+            row->cases = 0;
+        }
+        if (!(result->aggregates & AGGREGATE_DEATHS)) {
+            row->deaths = 0;
+        }
+        if (!(result->aggregates & AGGREGATE_CRITICAL_CASES)) {
+            row->criticalCases = 0;
+        }
+        if (!(result->aggregates & AGGREGATE_RECOVERED)) {
+            row->recovered = 0;
+        }
+    }
+}
+
+// Calculate a set of aggregates for all the infectious agents, or all the countries, of a table with a single pass over the infections
+tError infectionTable_groupBy(tInfectionTable* table, tGroupKey key, unsigned int aggregates, unsigned int partitions, tGroupResult* result) {
+    tGroupResult* partials;
+    tError* errors;
+    tGroupRow* row;
+    tError err;
+    unsigned int i, j;
+    int p;
+
+    // Verify pre conditions
+    assert(table != NULL);
+    assert(result != NULL);
+    assert(partitions > 0);
+
+    groupResult_clear(result, key, aggregates);
+
+    // Partitions of less than one infection are useless
+    if (partitions > table->size) {
+        partitions = (table->size > 0) ? table->size : 1;
+    }
+
+    // A single partition is aggregated directly into the result
+    if (partitions == 1) {
+        err = groupBy_partition(table, 0, table->size, result);
+        if (err == OK) {
+            groupBy_finish(result);
+        }
+        return err;
+    }
+
+    partials = (tGroupResult*)malloc(partitions * sizeof(tGroupResult));
+    errors = (tError*)malloc(partitions * sizeof(tError));
+    if (partials == NULL || errors == NULL) {
+        free(partials);
+        free(errors);
+        return ERR_MEMORY_ERROR;
+    }
+
+    // Each partition only reads its infections and writes its own result, so they can run at the same time, one thread for each partition
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(static) num_threads(partitions)
+#endif
+    for (p = 0; p < (int)partitions; p++) {
+        groupResult_init(&partials[p]);
+        groupResult_clear(&partials[p], key, aggregates);
+        errors[p] = groupBy_partition(table, (unsigned int)((unsigned long)table->size * p / partitions), (unsigned int)((unsigned long)table->size * (p + 1) / partitions), &partials[p]);
+    }
+
+    // Merge the partitions in the order of the table, so the groups keep the order of their first infection
+    err = OK;
+    for (i = 0; i < partitions; i++) {
+        if (errors[i] != OK) {
+            err = errors[i];
+        }
+        for (j = 0; j < partials[i].size && err == OK; j++) {
+            row = groupResult_row(result, partials[i].rows[j].name);
+            if (row == NULL) {
+                err = ERR_MEMORY_ERROR;
+            }
+            else {
+                groupBy_merge(row, &partials[i].rows[j]);
+            }
+        }
+        groupResult_free(&partials[i]);
+    }
+    free(partials);
+    free(errors);
+
+    if (err == OK) {
+        groupBy_finish(result);
+    }
+
+    return err;
+}
@@ -0,0 +1,214 @@
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "hash.h"
+
+// Minimum number of slots allocated for a non empty index
+#define HASH_MIN_CAPACITY 8
+
+// Compute the hash value of a string (FNV-1a)
+unsigned long hash_string(const char* str) {
+    unsigned long hash = 2166136261UL;
+
+    // Verify pre conditions
+    assert(str != NULL);
+
+    while (*str != '\0') {
+        hash ^= (unsigned char)*str;
+        hash *= 16777619UL;
+        str++;
+    }
+
+    return hash;
+}
+
+// Initialize an empty hash index
+void hashIndex_init(tHashIndex* index) {
+    // Verify pre conditions
+    assert(index != NULL);
+
+    // An empty index has no slots. Memory is allocated when the first key is added.
+    index->size = 0;
+    index->capacity = 0;
+    index->entries = NULL;
+}
+
+// Remove the memory used by the hash index
+void hashIndex_free(tHashIndex* index) {
+    // Verify pre conditions
+    assert(index != NULL);
+
+    // Keys and values are not owned by the index, only the slots must be freed
+    if (index->entries != NULL) {
+        free(index->entries);
+        index->entries = NULL;
+    }
+    index->size = 0;
+    index->capacity = 0;
+}
+
+// Remove all the keys of the index, keeping its memory
+void hashIndex_clear(tHashIndex* index) {
+    // Verify pre conditions
+    assert(index != NULL);
+
+    if (index->entries != NULL) {
+        memset(index->entries, 0, index->capacity * sizeof(tHashEntry));
+    }
+    index->size = 0;
+}
+
+// Place an entry in a table of slots. The key must not be in the table and there must be free slots
+static void hashIndex_place(tHashEntry* entries, unsigned int capacity, tHashEntry* entry) {
+    unsigned int pos;
+
+    // Linear probing: start on the slot given by the hash and move forward until a free slot is found
+    pos = entry->hash & (capacity - 1);
+    while (entries[pos].key != NULL) {
+        pos = (pos + 1) & (capacity - 1);
+    }
+    entries[pos] = *entry;
+}
+
+// Find the slot used by a key, or -1 if the key is not in the index
+static int hashIndex_slot(tHashIndex* index, const char* key, unsigned long hash) {
+    unsigned int pos;
+
+    if (index->size == 0) {
+        return -1;
+    }
+
+    // Move forward from the slot given by the hash until the key or a free slot is found
+    pos = hash & (index->capacity - 1);
+    while (index->entries[pos].key != NULL) {
+        if (index->entries[pos].hash == hash && strcmp(index->entries[pos].key, key) == 0) {
+            return pos;
+        }
+        pos = (pos + 1) & (index->capacity - 1);
+    }
+
+    return -1;
+}
+
+// Make room for at least count keys without growing again
+tError hashIndex_reserve(tHashIndex* index, unsigned int count) {
+    tHashEntry* entries;
+    unsigned int capacity;
+    unsigned int i;
+
+    // Verify pre conditions
+    assert(index != NULL);
+
+    // The index is kept at most 3/4 full, so probing sequences stay short
+    capacity = (index->capacity > 0) ? index->capacity : HASH_MIN_CAPACITY;
+    while (count > capacity - capacity / 4) {
+        capacity *= 2;
+    }
+    if (capacity == index->capacity) {
+        return OK;
+    }
+
+    // Allocate the new slots, all of them empty
+    entries = (tHashEntry*)calloc(capacity, sizeof(tHashEntry));
+    if (entries == NULL) {
+        return ERR_MEMORY_ERROR;
+    }
+
+    // Move the keys to the new slots. Positions depend on the capacity, so all keys must be placed again
+    for (i = 0; i < index->capacity; i++) {
+        if (index->entries[i].key != NULL) {
+            hashIndex_place(entries, capacity, &index->entries[i]);
+        }
+    }
+
+    if (index->entries != NULL) {
+        free(index->entries);
+    }
+    index->entries = entries;
+    index->capacity = capacity;
+
+    return OK;
+}
+
+// Add a key to the index. If the key already exists, its value is replaced
+tError hashIndex_put(tHashIndex* index, const char* key, void* value) {
+    tHashEntry entry;
+    tError err;
+    int pos;
+
+    // Verify pre conditions
+    assert(index != NULL);
+    assert(key != NULL);
+
+    entry.key = key;
+    entry.hash = hash_string(key);
+    entry.value = value;
+
+    // If the key already exists, replace its data
+    pos = hashIndex_slot(index, key, entry.hash);
+    if (pos >= 0) {
+        index->entries[pos] = entry;
+        return OK;
+    }
+
+    // Make room for the new key
+    err = hashIndex_reserve(index, index->size + 1);
+    if (err != OK) {
+        return err;
+    }
+
+    hashIndex_place(index->entries, index->capacity, &entry);
+    index->size++;
+
+    return OK;
+}
+
+// Get the value associated to a key, NULL if the key is not in the index
+void* hashIndex_get(tHashIndex* index, const char* key) {
+    int pos;
+
+    // Verify pre conditions
+    assert(index != NULL);
+    assert(key != NULL);
+
+    pos = hashIndex_slot(index, key, hash_string(key));
+    if (pos < 0) {
+        return NULL;
+    }
+
+    return index->entries[pos].value;
+}
+
+// Remove a key from the index. Returns false if the key was not in the index
+bool hashIndex_remove(tHashIndex* index, const char* key) {
+    unsigned int pos, next, home;
+    int slot;
+
+    // Verify pre conditions
+    assert(index != NULL);
+    assert(key != NULL);
+
+    slot = hashIndex_slot(index, key, hash_string(key));
+    if (slot < 0) {
+        return false;
+    }
+
+    // With linear probing we cannot just empty the slot, because it could break the probing sequence of the keys
+    // placed after it. The following keys of the sequence are moved back to fill the gap.
+    pos = slot;
+    next = (pos + 1) & (index->capacity - 1);
+    while (index->entries[next].key != NULL) {
+        home = index->entries[next].hash & (index->capacity - 1);
+        // The key at next can be moved to pos if its home slot is not in the cyclic range (pos, next]
+        if (((next - home) & (index->capacity - 1)) >= ((next - pos) & (index->capacity - 1))) {
+            index->entries[pos] = index->entries[next];
+            pos = next;
+        }
+        next = (next + 1) & (index->capacity - 1);
+    }
+    index->entries[pos].key = NULL;
+    index->entries[pos].value = NULL;
+    index->size--;
+
+    return true;
+}
@@ -2,10 +2,16 @@
 #include <stdlib.h>
 #include <assert.h>
 #include <string.h>
+#include <stdint.h>
 #include "commons.h"
 #include "infection.h"
 #include <stdio.h>
 
+// Initial number of infections that fit in a table
+#define INFECTION_TABLE_MIN_CAPACITY 4
+
+static tError agentInfections_update(tAgentInfections* agent, tInfection* infection, int cases, int deaths);
+
 // Initialize the Infection structure
 tError infection_init(tInfection* object, tInfectiousAgent* infectiousAgent, tCountry* country, tDate* date){
     // Verify pre conditions
@@ -14,13 +20,17 @@ tError infection_init(tInfection* object, tInfectiousAgent* infectiousAgent, tCo
     assert(country != NULL);
     assert(date != NULL);
 
+    object->borrowed = false;
+    object->agent = NULL;
+
     // Allocate the memory for all the fields. To allocate memory we use the malloc command.
     object->country = (tCountry*)malloc(sizeof(tCountry));
 
     // Allocate the memory for the date field. We use the malloc command.
     object->date = (tDate*)malloc(sizeof(tDate));
 
-    object->infectiousAgent = (tInfectiousAgent*)malloc(sizeof(tInfectiousAgent));
+    // The agent is allocated empty (all its fields NULL), as infectiousAgent_cpy requires
+    object->infectiousAgent = (tInfectiousAgent*)calloc(1, sizeof(tInfectiousAgent));
 
 
     // Check that memory has been allocated for all fields. Pointer must be different from NULL.
@@ -47,11 +57,54 @@ tError infection_init(tInfection* object, tInfectiousAgent* infectiousAgent, tCo
     return OK;
 }
 
+// Initialize the Infection structure as a handle to an infectious agent and a country owned by someone else
+tError infection_initHandle(tInfection* object, tInfectiousAgent* infectiousAgent, tCountry* country, tDate* date){
+    // Verify pre conditions
+    assert(object != NULL);
+    assert(infectiousAgent != NULL);
+    assert(country != NULL);
+    assert(date != NULL);
+
+    // The infectious agent and the country are only referenced, so the date is the only allocation of the handle
+    object->borrowed = true;
+    object->agent = NULL;
+    object->infectiousAgent = infectiousAgent;
+    object->country = country;
+    object->date = (tDate*)malloc(sizeof(tDate));
+    if (object->date == NULL) {
+        object->infectiousAgent = NULL;
+        object->country = NULL;
+        return ERR_MEMORY_ERROR;
+    }
+    *object->date = *date;
+
+    object->totalCases = 0;
+    object->totalCriticalCases = 0;
+    object->totalDeaths = 0;
+    object->totalRecovered = 0;
+
+    return OK;
+}
+
+// Initialize an infection with the same mode (copy or handle) as another one
+static tError infection_initLike(tInfection* object, tInfection* model){
+    if (model->borrowed) {
+        return infection_initHandle(object, model->infectiousAgent, model->country, model->date);
+    }
+    return infection_init(object, model->infectiousAgent, model->country, model->date);
+}
+
 // Remove the memory used by Infection structure
 void infection_free(tInfection* object){
     // Verify pre conditions
     assert(object != NULL);
 
+    // The infectious agent and the country of a handle belong to their owner, only the reference is dropped
+    if (object->borrowed) {
+        object->infectiousAgent = NULL;
+        object->country = NULL;
+    }
+
     // All memory allocated with malloc and realloc needs to be freed using the free command. In this case, as we use malloc to allocate the fields, we have to free them
     if (object->country != NULL) {
         country_free(object->country);
@@ -80,6 +133,11 @@ void infection_update(tInfection* infection, int cases, int deaths, int critical
     assert(criticalCases >= 0);
     assert(recovered >= 0);
 
+    // The infections in a table also update the rollups of their infectious agent. If they cannot be updated, the infection is not changed either
+    if (infection->agent != NULL && agentInfections_update(infection->agent, infection, infection->totalCases + cases, infection->totalDeaths + deaths) != OK) {
+        return;
+    }
+
     infection->totalCases += cases;
     infection->totalDeaths += deaths;
     infection->totalCriticalCases += criticalCases;
@@ -88,13 +146,19 @@ void infection_update(tInfection* infection, int cases, int deaths, int critical
 
 // Update cases and deaths of an Infection rescursively
 void infection_update_recursive(tInfection* infection){
+    tCityTotals totals;
+
     assert(infection != NULL);
 
-    int totalCases = country_totalCases(infection->country);
-    infection->totalCases = totalCases;
-    infection->totalDeaths = country_totalDeaths(infection->country);
-    infection->totalCriticalCases = country_totalCriticalCases(infection->country);
-    infection->totalRecovered = country_totalRecovered(infection->country);
+    // All the totals are calculated with a single pass over the cities of the country
+    totals = country_totals(infection->country);
+    if (infection->agent != NULL && agentInfections_update(infection->agent, infection, totals.cases, totals.deaths) != OK) {
+        return;
+    }
+    infection->totalCases = totals.cases;
+    infection->totalDeaths = totals.deaths;
+    infection->totalCriticalCases = totals.critical_cases;
+    infection->totalRecovered = totals.recovered;
 
 }
 
@@ -131,13 +195,229 @@ void infectionTable_init(tInfectionTable* table){
     table->size = 0;
     // Using dynamic memory, the pointer to the elements must be set to NULL (no memory allocated). This is the main difference with respect to the reservoir of static memory, were data was allways initialized (tInfection elements[MAX_ELEMENTS])
     table->elements = NULL;
+    table->capacity = 0;
+
+    // The index has an entry for each infectious agent in the table
+    hashIndex_init(&table->agents);
+
+    // Keep the order of the table by default
+    table->removeMode = REMOVE_SHIFT;
+    table->removed = 0;
+}
+
+// Get the infections of an infectious agent in the table, NULL if it has none
+static tAgentInfections* infectionTable_agent(tInfectionTable* table, const char* infectiousAgentName) {
+    return (tAgentInfections*)hashIndex_get(&table->agents, infectiousAgentName);
+}
+
+// Remove the memory used by the infections of an infectious agent
+static void agentInfections_free(tAgentInfections* agent) {
+    hashIndex_free(&agent->countries);
+    if (agent->ranking != NULL) {
+        free(agent->ranking);
+    }
+    free(agent->name);
+    free(agent);
+}
+
+// Check if an entry of the ranking goes before another one: more cases, then more deaths, and then the first in the table
+static bool agentInfections_before(tInfectionRank* rank1, tInfectionRank* rank2) {
+    if (rank1->cases != rank2->cases) {
+        return rank1->cases > rank2->cases;
+    }
+    if (rank1->deaths != rank2->deaths) {
+        return rank1->deaths > rank2->deaths;
+    }
+    return rank1->pos < rank2->pos;
+}
+
+// Place an entry in a slot of the ranking, and update the slot of its country in the index
+static tError agentInfections_place(tAgentInfections* agent, unsigned int slot, tInfectionRank* rank) {
+    agent->ranking[slot] = *rank;
+    return hashIndex_put(&agent->countries, rank->country, (void*)(intptr_t)(slot + 1));
+}
+
+// Move the entry of a slot up or down the heap until it is in order again
+static tError agentInfections_sift(tAgentInfections* agent, unsigned int slot) {
+    tInfectionRank rank;
+    unsigned int parent, child;
+    tError err;
+
+    rank = agent->ranking[slot];
+
+    // Move up while the entry goes before its parent
+    while (slot > 0) {
+        parent = (slot - 1) / 2;
+        if (!agentInfections_before(&rank, &agent->ranking[parent])) {
+            break;
+        }
+        err = agentInfections_place(agent, slot, &agent->ranking[parent]);
+        if (err != OK) {
+            return err;
+        }
+        slot = parent;
+    }
+
+    // Move down while one of the children goes before the entry
+    while ((child = 2 * slot + 1) < agent->size) {
+        if (child + 1 < agent->size && agentInfections_before(&agent->ranking[child + 1], &agent->ranking[child])) {
+            child++;
+        }
+        if (!agentInfections_before(&agent->ranking[child], &rank)) {
+            break;
+        }
+        err = agentInfections_place(agent, slot, &agent->ranking[child]);
+        if (err != OK) {
+            return err;
+        }
+        slot = child;
+    }
+
+    return agentInfections_place(agent, slot, &rank);
+}
+
+// Update the rollups of an agent with the new totals of one of its infections
+static tError agentInfections_update(tAgentInfections* agent, tInfection* infection, int cases, int deaths) {
+    unsigned int slot;
+
+    slot = (unsigned int)(intptr_t)hashIndex_get(&agent->countries, infection->country->name) - 1;
+    assert(slot < agent->size);
+
+    agent->totalCases += cases - infection->totalCases;
+    agent->totalDeaths += deaths - infection->totalDeaths;
+    agent->ranking[slot].cases = cases;
+    agent->ranking[slot].deaths = deaths;
+    return agentInfections_sift(agent, slot);
+}
+
+// Add the infection at position pos to the index. If the (infectious agent, country) pair is already indexed, its position is updated.
+static tError infectionTable_indexElement(tInfectionTable* table, unsigned int pos) {
+    tInfection* infection;
+    tAgentInfections* agent;
+    tInfectionRank rank;
+    intptr_t slot;
+    tError err;
+
+    infection = &table->elements[pos];
+    agent = infectionTable_agent(table, infection->infectiousAgent->name);
+    if (agent == NULL) {
+        // First infection of this infectious agent
+        agent = (tAgentInfections*)malloc(sizeof(tAgentInfections));
+        if (agent == NULL) {
+            return ERR_MEMORY_ERROR;
+        }
+        agent->name = (char*)malloc((strlen(infection->infectiousAgent->name) + 1) * sizeof(char));
+        if (agent->name == NULL) {
+            free(agent);
+            return ERR_MEMORY_ERROR;
+        }
+        strcpy(agent->name, infection->infectiousAgent->name);
+        hashIndex_init(&agent->countries);
+        agent->ranking = NULL;
+        agent->size = 0;
+        agent->capacity = 0;
+        agent->totalCases = 0;
+        agent->totalDeaths = 0;
+
+        err = hashIndex_put(&table->agents, agent->name, agent);
+        if (err != OK) {
+            agentInfections_free(agent);
+            return err;
+        }
+    }
+
+    // The key of the entry is the name of the country of the infection, so it must be set again when the infection is copied to another position
+    rank.country = infection->country->name;
+    rank.pos = pos;
+    rank.cases = infection->totalCases;
+    rank.deaths = infection->totalDeaths;
+
+    slot = (intptr_t)hashIndex_get(&agent->countries, rank.country);
+    if (slot > 0) {
+        // The totals of the infection are already in the rollups, only its position changes
+        agent->ranking[slot - 1] = rank;
+        infection->agent = agent;
+        return agentInfections_sift(agent, (unsigned int)(slot - 1));
+    }
+
+    // Make room for the new entry of the ranking
+    err = array_reserve(&agent->ranking, &agent->capacity, agent->size + 1, sizeof(tInfectionRank), INFECTION_RANKING_MIN_CAPACITY);
+    if (err == OK) {
+        err = hashIndex_put(&agent->countries, rank.country, (void*)(intptr_t)(agent->size + 1));
+    }
+    if (err != OK) {
+        if (agent->size == 0) {
+            hashIndex_remove(&table->agents, agent->name);
+            agentInfections_free(agent);
+        }
+        return err;
+    }
+
+    agent->ranking[agent->size] = rank;
+    agent->size++;
+    agent->totalCases += rank.cases;
+    agent->totalDeaths += rank.deaths;
+    infection->agent = agent;
+
+    return agentInfections_sift(agent, agent->size - 1);
+}
+
+// Remove the infection at position pos from the index, while its names are still allocated
+static tError infectionTable_unindexElement(tInfectionTable* table, unsigned int pos) {
+    tInfection* infection;
+    tAgentInfections* agent;
+    unsigned int slot;
+    tError err;
+
+    infection = &table->elements[pos];
+    agent = infectionTable_agent(table, infection->infectiousAgent->name);
+    if (agent == NULL) {
+        return OK;
+    }
+
+    slot = (unsigned int)(intptr_t)hashIndex_get(&agent->countries, infection->country->name) - 1;
+    if (slot >= agent->size) {
+        return OK;
+    }
+    hashIndex_remove(&agent->countries, infection->country->name);
+    agent->totalCases -= infection->totalCases;
+    agent->totalDeaths -= infection->totalDeaths;
+    infection->agent = NULL;
+
+    // The last entry of the heap fills the slot of the removed one
+    agent->size--;
+    if (slot < agent->size) {
+        err = agentInfections_place(agent, slot, &agent->ranking[agent->size]);
+        if (err == OK) {
+            err = agentInfections_sift(agent, slot);
+        }
+        return err;
+    }
+
+    // Infectious agents without infections are not kept in the index
+    if (agent->size == 0) {
+        hashIndex_remove(&table->agents, agent->name);
+        agentInfections_free(agent);
+    }
+
+    return OK;
 }
 
 // Remove the memory used by InfectionTable structure
 void infectionTable_free(tInfectionTable* object){
+    unsigned int i;
+
     // Verify pre conditions
     assert(object != NULL);
 
+    // Remove the index. Each infectious agent has its own index of countries.
+    for (i = 0; i < object->agents.capacity; i++) {
+        if (object->agents.entries[i].key != NULL) {
+            agentInfections_free((tAgentInfections*)object->agents.entries[i].value);
+        }
+    }
+    hashIndex_free(&object->agents);
+
     // All memory allocated with malloc and realloc needs to be freed using the free command. In this case, as we use malloc/realloc to allocate the elements, and need to free them.
     if (object->elements != NULL) {
         for (int i = 0; i < object->size; i++) {
@@ -145,14 +425,18 @@ void infectionTable_free(tInfectionTable* object){
         }
         free(object->elements);
         object->elements = NULL;
-        // As the table is now empty, assign the size to 0.
-        object->size = 0;
     }
+    // As the table is now empty, assign the size to 0.
+    object->size = 0;
+    object->capacity = 0;
+    object->removed = 0;
 
 }
 
 // Add a new Infection to the table
 tError infectionTable_add(tInfectionTable* table, tInfection* infection){
+    tError err;
+
     // Verify pre conditions
     assert(table != NULL);
     assert(infection != NULL);
@@ -161,34 +445,31 @@ tError infectionTable_add(tInfectionTable* table, tInfection* infection){
     if (infectionTable_find(table, infection->infectiousAgent->name, infection->country))
         return ERR_DUPLICATED;
 
-    // The first step is to allocate the required space. There are two methods to manage the memory (malloc and realloc). Malloc allows to allocate a new memory block, while realloc allows to modify an existing memory block.    
-    if (table->size == 0) {
-        // Empty table
-
-        // Increase the number of elements of the table
-        table->size = 1;
-
-        // Since the table is empty, and we do not have any previous memory block, we have to use malloc. The amount of memory we need is the number of elements (will be 1) times the size of one element, which is computed by sizeof(type). In this case the type is tInfection.
-        table->elements = (tInfection*)malloc(table->size * sizeof(tInfection));
+    // The first step is to allocate the required space (see array_reserve). The index stores positions, so it is still valid if the block is moved.
+    err = array_reserve(&table->elements, &table->capacity, table->size + 1, sizeof(tInfection), INFECTION_TABLE_MIN_CAPACITY);
+    if (err != OK) {
+        return err;
     }
-    else {
-        // table with elements
-
-        // Increase the number of elements of the table
-        table->size = table->size + 1;
 
-        // Since the table is not empty, we already have a memory block. We need to modify the size of this block, using the realloc command. The amount of memory we need is the number of elements times the size of one element, which is computed by sizeof(type). In this case the type is tInfection. We provide the previous block of memory.
-        table->elements = (tInfection*)realloc(table->elements, table->size * sizeof(tInfection));
+    // Once we have the block of memory, which is an array of tInfection elements, we initialize the new element in the first free position, " table->elements[table->size] " (we start counting at 0)
+    // Handles are added as handles, so the table does not copy the infectious agent and the country
+    err = infection_initLike(&(table->elements[table->size]), infection);
+    if (err != OK) {
+        // The position is still free, so the table is not changed
+        return err;
     }
 
-    // Check that the memory has been allocated
-    if (table->elements == NULL) {
-        // Error allocating or reallocating the memory
-        return ERR_MEMORY_ERROR;
+    err = infectionTable_indexElement(table, table->size);
+    if (err != OK) {
+        // The infection cannot be found without the index, so it is not added
+        infection_free(&(table->elements[table->size]));
+        return err;
     }
 
-    // Once we have the block of memory, which is an array of tInfection elements, we initialize the new element (which is the last one). The last element is " table->elements[table->size - 1] " (we start counting at 0)
-    return infection_init(&(table->elements[table->size - 1]), infection->infectiousAgent, infection->country, infection->date);
+    // Increase the number of elements of the table, once the new element is initialized and indexed
+    table->size = table->size + 1;
+
+    return OK;
 
 }
 
@@ -197,31 +478,33 @@ unsigned int infectionTable_size(tInfectionTable* table){
     // Verify pre conditions
     assert(table != NULL);
 
-    // The size of the table is the number of elements. This value is stored in the "size" field.
-    return table->size;
+    // The size of the table is the number of elements. The removed infections still in the array are not counted
+    return table->size - table->removed;
 }
 
 // Get Infection by Infection and country name
 tInfection* infectionTable_find(tInfectionTable* table, const char* infectiousAgentName, tCountry* country){
-    int i;
+    tAgentInfections* agent;
+    intptr_t slot;
 
     // Verify pre conditions
     assert(table != NULL);
     assert(infectiousAgentName != NULL);
     assert(country != NULL);
 
-    // Search over the table and return once we found the element.
-    for (i = 0; i<table->size; i++) {
-        if ((strcmp(table->elements[i].infectiousAgent->name, infectiousAgentName) == 0)) {
-            if (country_equal(table->elements[i].country, country)) {
-                // We return the ADDRESS (&) of the element, which is a pointer to the element
-                return &(table->elements[i]);
-            }
-        }
+    // Look for the infectious agent, and then for the country among its infections. Both lookups are O(1), instead of a scan of the table.
+    agent = infectionTable_agent(table, infectiousAgentName);
+    if (agent == NULL) {
+        return NULL;
+    }
+    slot = (intptr_t)hashIndex_get(&agent->countries, country->name);
+    if (slot == 0) {
+        // The element has not been found. Return NULL (empty pointer).
+        return NULL;
     }
 
-    // The element has not been found. Return NULL (empty pointer).
-    return NULL;
+    // We return the ADDRESS (&) of the element, which is a pointer to the element
+    return &(table->elements[agent->ranking[slot - 1].pos]);
 }
 
 // Compare two Table of infections
@@ -231,12 +514,16 @@ bool infectionTable_equals(tInfectionTable* infectionTable1, tInfectionTable* in
     assert(infectionTable2 != NULL);
 
     int i;
-    if (infectionTable1->size != infectionTable2->size){
+    if (infectionTable_size(infectionTable1) != infectionTable_size(infectionTable2)){
         return false;
     }
 
-    for (i = 0; i< infectionTable1->size; i++)
+    for (i = 0; i< infectionTable2->size; i++)
     {
+        // Removed infections have no infectious agent
+        if (infectionTable2->elements[i].infectiousAgent == NULL) {
+            continue;
+        }
         // Uses "find" because the order of reservoirs could be different
         if (!infectionTable_find(infectionTable1, infectionTable2->elements[i].infectiousAgent->name, infectionTable2->elements[i].country)) {
             // names are different
@@ -258,98 +545,147 @@ tError infection_cpy(tInfection* dst, tInfection* src){
         infection_free(dst);
 
     // Initialize the element with the new data
-    return infection_init(dst, src->infectiousAgent, src->country, src->date);
+    return infection_initLike(dst, src);
 
 }
 
 // Remove a Infection from the table
 tError infectionTable_remove(tInfectionTable* table, tInfection* infection){
-    int i;
-    bool found;
+    tInfection* element;
+    unsigned int i, pos, last;
+    tError err;
 
     // Verify pre conditions
     assert(table != NULL);
     assert(infection != NULL);
 
-    // To remove an element of a table, we will move all elements after this element one position, to fill the space of the removed element.
-    found = false;
-    for (i = 0; i<table->size; i++) {
-        // If the element has been found. Displace this element to the previous element (will never happend for the first one). We use the ADDRESS of the previous element &(table->elements[i-1]) as destination, and ADDRESS of the current element &(table->elements[i]) as source.
-        if (found) {
-            // Check the return code to detect memory allocation errors
-            if (infection_cpy(&(table->elements[i - 1]), &(table->elements[i])) == ERR_MEMORY_ERROR) {
-                // Error allocating memory. Just stop the process and return memory error.
-                return ERR_MEMORY_ERROR;
-            }
-        }
-        else if (infection_equals(&table->elements[i], infection)){
-            // The current element is the element we want to remove. Set found flag to true to start element movement.
-            found = true;
-        }
+    element = infectionTable_find(table, infection->infectiousAgent->name, infection->country);
+    if (element == NULL) {
+        // If the element was not in the table, return an error.
+        return ERR_NOT_FOUND;
     }
 
-    // Once removed the element, we need to modify the memory used by the table.
-    if (found) {
-        // If we are removing the last element, we will free 
-        // the last/remaining element in table / assign pointer 
-        // to NULL
-        if (table->size <= 1) {
-            infectionTable_free(table);
+    // If we are removing the last element, we will free the last/remaining element in table / assign pointer to NULL
+    if (infectionTable_size(table) <= 1) {
+        infectionTable_free(table);
+        return OK;
+    }
+
+    // Remove the infection from the index while its names are still allocated. Then free it, which is the only memory released.
+    // The element is removed from the table even if the index fails, and the first error is returned
+    pos = element - table->elements;
+    err = infectionTable_unindexElement(table, pos);
+    infection_free(element);
+
+    if (table->removeMode == REMOVE_TOMBSTONE) {
+        // The freed infection has a NULL infectious agent, which marks it as removed. No element is moved, so the pointers to the other infections are still valid.
+        table->removed++;
+        // When most of the array are gaps, scans waste their time on them. Then the table is compacted, so the cost of compacting is amortized over all the removals.
+        if (table->removed > table->size / 2 && err == OK) {
+            return infectionTable_compact(table);
         }
-        else {
-            infection_free(&table->elements[table->size - 1]);
-            // Modify the used memory. As we are modifying a previously 
-            // allocated block, we need to use the realloc command.
-            table->elements = (tInfection*)realloc(table->elements, table->size * sizeof(tInfection));
-
-            // Check that the memory has been allocated
-            if (table->elements == NULL) {
-                // Error allocating or reallocating the memory
-                return ERR_MEMORY_ERROR;
-            }
-            else {
-                // Succesfully allocated, set new table size
-                table->size = table->size - 1;
+        return err;
+    }
+
+    // To fill the space of the removed element, the structures are moved as raw memory. The copies of the infectious agent and the country belong to the moved infection, so they are not copied: no memory is allocated or freed.
+    // The moved infections are already in the index, so indexing them again only updates their positions.
+    if (table->removeMode == REMOVE_SWAP) {
+        // Move the last element to the gap
+        last = table->size - 1;
+        if (pos != last) {
+            table->elements[pos] = table->elements[last];
+            if (err == OK) {
+                err = infectionTable_indexElement(table, pos);
             }
         }
     }
     else {
-        // If the element was not in the table, return an error.
-        return ERR_NOT_FOUND;
+        // Move all elements after this element one position
+        memmove(&table->elements[pos], &table->elements[pos + 1], (table->size - pos - 1) * sizeof(tInfection));
+        for (i = pos; i < table->size - 1 && err == OK; i++) {
+            err = infectionTable_indexElement(table, i);
+        }
+    }
+
+    // The memory block keeps its capacity (see array_capacity)
+    table->size = table->size - 1;
+
+    return err;
+}
+
+// Set how the gap left by a removed infection is filled. Leaving REMOVE_TOMBSTONE compacts the table
+tError infectionTable_setRemoveMode(tInfectionTable* table, tRemoveMode mode) {
+    // Verify pre conditions
+    assert(table != NULL);
+
+    table->removeMode = mode;
+
+    // Only tables in REMOVE_TOMBSTONE mode can have removed infections
+    if (mode != REMOVE_TOMBSTONE) {
+        return infectionTable_compact(table);
     }
 
     return OK;
 }
 
+// Remove the infections marked as removed from the array, moving the others to fill the gaps. The order of the table is kept
+tError infectionTable_compact(tInfectionTable* table) {
+    unsigned int i, last;
+    tError err;
+
+    // Verify pre conditions
+    assert(table != NULL);
+
+    if (table->removed == 0) {
+        // There are no gaps
+        return OK;
+    }
+
+    // Go over the table once, moving the infections to the first free position and updating their positions in the index. All the gaps are removed even if the index fails, and the first error is returned
+    err = OK;
+    last = 0;
+    for (i = 0; i < table->size; i++) {
+        if (table->elements[i].infectiousAgent != NULL) {
+            if (last != i) {
+                table->elements[last] = table->elements[i];
+                if (err == OK) {
+                    err = infectionTable_indexElement(table, last);
+                }
+            }
+            last++;
+        }
+    }
+    table->size = last;
+    table->removed = 0;
+
+    return err;
+}
+
 // Given an infectious agent and a table of type tinfectionTable, 
 // it performs a search of the country with the largest infected population, 
 // offering us a pointer to it. In case of a tie, the country that is first on the list will be returned. 
 // In case of not finding the infectious agent in the list, it will return NULL.
 
 tInfection* infectionTable_getMaxInfection(tInfectionTable* table, const char* infectiousAgentName){
-    int maxCases = 0;
-    int maxDeaths = 0;
-    int i;
-    tInfection * infection = NULL;
+    tAgentInfections* agent;
+    tInfectionRank* max;
 
-    for (i = 0; i<table->size; i++) {
-        if (strcmp(table->elements[i].infectiousAgent->name, infectiousAgentName) == 0){
-            if (table->elements[i].totalCases > maxCases){
-                infection = &table->elements[i];
-                maxCases = table->elements[i].totalCases;
-            }
-            if (table->elements[i].totalCases == maxCases && table->elements[i].totalDeaths > maxDeaths){
-                infection = &table->elements[i];
-                maxDeaths = table->elements[i].totalDeaths;
+    // Verify pre conditions
+    assert(table != NULL);
+    assert(infectiousAgentName != NULL);
 
-            }
-        }
+    agent = infectionTable_agent(table, infectiousAgentName);
+    if (agent == NULL) {
+        return NULL;
     }
 
+    // The top of the ranking is the infection with most cases, then most deaths, and then the first on the table. Infections without cases nor deaths are not returned.
+    max = &agent->ranking[0];
+    if (max->cases == 0 && max->deaths == 0) {
+        return NULL;
+    }
 
-
-
-    return infection;
+    return &table->elements[max->pos];
 
 }
 
@@ -358,17 +694,20 @@ tInfection* infectionTable_getMaxInfection(tInfectionTable* table, const char* i
 // adding all the deceased and dividing it by the number of affected.
 
 float infectionTable_getMortalityRate(tInfectionTable* table, const char* infectiousAgentName){
-    int cases = 0;
-    int deaths = 0;
+    tAgentInfections* agent;
+    long cases = 0;
+    long deaths = 0;
     float mortalityRate = 0;
-    int i;
 
-    for (i = 0; i<table->size; i++) {
-        if (strcmp(table->elements[i].infectiousAgent->name, infectiousAgentName) == 0){
-            cases += table->elements[i].totalCases;
-            deaths += table->elements[i].totalDeaths;
+    // Verify pre conditions
+    assert(table != NULL);
+    assert(infectiousAgentName != NULL);
 
-        }
+    // The sums of the infections of the agent are kept by the index
+    agent = infectionTable_agent(table, infectiousAgentName);
+    if (agent != NULL) {
+        cases = agent->totalCases;
+        deaths = agent->totalDeaths;
     }
 
     mortalityRate = (float)deaths / (float)cases;
@@ -2,11 +2,120 @@
 #include <string.h>
 #include <assert.h>
 #include <stdio.h>
+#include <stdint.h>
 #include "infectiousAgent.h"
+#include "stringPool.h"
+
+// Number of elements allocated the first time an infectious agent is added to an empty table
+#define INFECTIOUS_AGENT_TABLE_MIN_CAPACITY 4
+
+// Add the reservoirs of an infectious agent to the index of species
+static tError speciesIndex_add(tHashIndex* index, const char* name, tReservoirTable* reservoirs) {
+    tSpeciesEntry* entry;
+    tReservoir* reservoir;
+
+    for (int i = 0; i < reservoirs->size; i++) {
+        reservoir = &reservoirs->elements[i];
+
+        // Get the entry of the species, creating it the first time the species is found
+        entry = (tSpeciesEntry*)hashIndex_get(index, reservoir->species);
+        if (entry == NULL) {
+            entry = (tSpeciesEntry*)malloc(sizeof(tSpeciesEntry));
+            if (entry == NULL) {
+                return ERR_MEMORY_ERROR;
+            }
+            entry->species = stringPool_intern(reservoir->species);
+            entry->size = 0;
+            entry->capacity = 0;
+            entry->refs = NULL;
+            if (entry->species == NULL || hashIndex_put(index, entry->species, entry) != OK) {
+                free(entry);
+                return ERR_MEMORY_ERROR;
+            }
+        }
+
+        // Make room for the new reference
+        if (array_reserve(&entry->refs, &entry->capacity, entry->size + 1, sizeof(tSpeciesRef), 4) != OK) {
+            return ERR_MEMORY_ERROR;
+        }
+
+        // The index keeps its own references to the names, so it does not depend on the lifetime of the agent
+        entry->refs[entry->size].agent = stringPool_intern(name);
+        entry->refs[entry->size].reservoir = stringPool_intern(reservoir->name);
+        entry->size++;
+    }
+
+    return OK;
+}
+
+// Remove the memory used by an entry of the index of species
+static void speciesEntry_free(tSpeciesEntry* entry) {
+    for (int i = 0; i < entry->size; i++) {
+        stringPool_release(entry->refs[i].agent);
+        stringPool_release(entry->refs[i].reservoir);
+    }
+    if (entry->refs != NULL) {
+        free(entry->refs);
+    }
+    stringPool_release(entry->species);
+    free(entry);
+}
+
+// Remove the reservoirs of an infectious agent from the index of species. They must be the same reservoirs given to speciesIndex_add
+static void speciesIndex_remove(tHashIndex* index, const char* name, tReservoirTable* reservoirs) {
+    tSpeciesEntry* entry;
+    tReservoir* reservoir;
+    const char* agentName;
+
+    // The references keep the name of the agent from the string pool. Getting the same string from the pool, the references can be compared by address instead of comparing the strings.
+    agentName = stringPool_intern(name);
+    if (agentName == NULL) {
+        return;
+    }
+
+    for (int i = 0; i < reservoirs->size; i++) {
+        reservoir = &reservoirs->elements[i];
+
+        entry = (tSpeciesEntry*)hashIndex_get(index, reservoir->species);
+        if (entry == NULL) {
+            continue;
+        }
+
+        // Find the reference and fill its gap with the last one. All the names come from the string pool, so they are compared by address.
+        for (int j = 0; j < entry->size; j++) {
+            if (entry->refs[j].reservoir == reservoir->name && entry->refs[j].agent == agentName) {
+                stringPool_release(entry->refs[j].agent);
+                stringPool_release(entry->refs[j].reservoir);
+                entry->refs[j] = entry->refs[entry->size - 1];
+                entry->size--;
+                break;
+            }
+        }
+
+        // Remove the species when no agent has it
+        if (entry->size == 0) {
+            hashIndex_remove(index, entry->species);
+            speciesEntry_free(entry);
+        }
+    }
+
+    stringPool_release(agentName);
+}
+
+// Remove the memory used by the index of species
+static void speciesIndex_free(tHashIndex* index) {
+    for (int i = 0; i < index->capacity; i++) {
+        if (index->entries[i].key != NULL) {
+            speciesEntry_free((tSpeciesEntry*)index->entries[i].value);
+        }
+    }
+    hashIndex_free(index);
+}
 
 // Initialize the infectious agent structure
 tError infectiousAgent_init(tInfectiousAgent* object, char* name, float r0, char* medium, tDate* date, char* city, tReservoirTable* reservoirList) {
-    tReservoir element;
+    size_t nameLength, mediumLength, cityLength;
+    char* block;
 
     // Verify pre conditions
     assert(object != NULL);
@@ -17,57 +126,48 @@ tError infectiousAgent_init(tInfectiousAgent* object, char* name, float r0, char
     assert(city != NULL);
     assert(reservoirList != NULL);
 
-    // Allocate the memory for all the string fields, using the length of the provided text plus 1 space for the "end of string" char '\0'.
-    // To allocate memory we use the malloc command.
-    object->name = (char*)malloc((strlen(name) + 1) * sizeof(char));
-    object->medium = (char*)malloc((strlen(medium) + 1) * sizeof(char));
-    object->city = (char *)malloc((strlen(city) + 1) * sizeof(char));
-
-    // Check that memory has been allocated for all fields. Pointer must be different from NULL.
-    if (object->name == NULL || object->medium == NULL || object->city == NULL) {
-        // Some of the string fields have a NULL value, what means that we found some problem allocating the memory
-        return ERR_MEMORY_ERROR;
-    }
-
-    // Allocate the memory for the date field. We use the malloc command.
-    object->date = (tDate*)malloc(sizeof(tDate));
+    // All the string fields of the agent are stored in a single block of memory, each one using the length of the provided text plus 1 space for the "end of string" char '\0'.
+    // With one allocation instead of one per field, the data of an agent is contiguous and scanning a table touches less memory.
+    nameLength = strlen(name) + 1;
+    mediumLength = strlen(medium) + 1;
+    cityLength = strlen(city) + 1;
+    block = (char*)malloc((nameLength + mediumLength + cityLength) * sizeof(char));
 
     // Check that memory has been allocated.
-    if (object->date == NULL) {
+    if (block == NULL) {
         // We found some problem allocating the memory
         return ERR_MEMORY_ERROR;
     }
 
-    // Allocate the memory for the reservoir list field. We use the malloc command.
-    // First we need to allocate the memory for the tReservoirTable and init the strucutre.
-    // After this, we copy all the elements.
-    object->reservoirList = (tReservoirTable*)malloc(sizeof(tReservoirTable));
-    //object->reservoirList->elements = (tReservoir*) malloc(reservoirList->size * sizeof(tReservoir));
-    reservoirTable_init(object->reservoirList);
+    // The fields point to their position in the block
+    object->name = block;
+    object->medium = object->name + nameLength;
+    object->city = object->medium + mediumLength;
 
-    for (int i = 0; i < reservoirList->size; i++) {
-        reservoir_init(&element, reservoirList->elements[i].name, reservoirList->elements[i].species);
-        reservoirTable_add(object->reservoirList, &element);
-        reservoir_free(&element);
-    }
+    // The reservoir list is shared between the infectious agents. If the given list is already shared (for example, it is the list of another agent) we just use it, otherwise a shared copy is made.
+    object->reservoirList = reservoirTable_share(reservoirList);
 
     // Check that memory has been allocated.
-    if (object->reservoirList == NULL) { //|| object->reservoirList->elements == NULL) {
-        // We found some problem allocating the memory
+    if (object->reservoirList == NULL) {
+        // We found some problem allocating the memory. Give back the block of the fields.
+        free(block);
+        object->name = NULL;
+        object->medium = NULL;
+        object->city = NULL;
         return ERR_MEMORY_ERROR;
     }
 
     // Once the memory is allocated, copy the data.
 
-    // As the fields are strings, we need to use the string copy function strcpy. 
-    strcpy(object->name, name);
-    strcpy(object->medium, medium);
-    strcpy(object->city, city);
+    // As the fields are strings, we need to copy their characters. We already know their length, including the "end of string" char.
+    memcpy(object->name, name, nameLength * sizeof(char));
+    memcpy(object->medium, medium, mediumLength * sizeof(char));
+    memcpy(object->city, city, cityLength * sizeof(char));
 
     // As the field date is a struct, we need to copy all fields.
-    object->date->day = date->day;
-    object->date->month = date->month;
-    object->date->year = date->year;
+    object->date.day = date->day;
+    object->date.month = date->month;
+    object->date.year = date->year;
 
     // Create all the elements of the reservoir list.
     /*
@@ -94,8 +194,7 @@ void infectiousAgent_free(tInfectiousAgent* object) {
     assert(object != NULL);
 
     // All memory allocated with malloc and realloc needs to be freed using the free command.
-    // In this case, as we use malloc to allocate the fields, we have to free them
-
+    // In this case, all the string fields are stored in a single block, that starts with the name.
 
     object->r0 = 0;
 
@@ -104,24 +203,12 @@ void infectiousAgent_free(tInfectiousAgent* object) {
         object->name = NULL;
     }
 
-    if (object->medium != NULL) {
-        free(object->medium);
-        object->medium = NULL;
-    }
-
-    if (object->date != NULL) {
-        free(object->date);
-        object->date = NULL;
-    }
-
-    if (object->city != NULL) {
-        free(object->city);
-        object->city = NULL;
-    }
+    object->medium = NULL;
+    object->city = NULL;
 
+    // The reservoir list could be used by other agents, so it is given back instead of freed
     if (object->reservoirList != NULL) {
-        reservoirTable_free(object->reservoirList);
-        free(object->reservoirList);
+        reservoirTable_release(object->reservoirList);
         object->reservoirList = NULL;
     }
 
@@ -129,6 +216,46 @@ void infectiousAgent_free(tInfectiousAgent* object) {
 
 }
 
+// Get the name of an infectious agent
+const char* infectiousAgent_getName(tInfectiousAgent* object) {
+    // Verify pre conditions
+    assert(object != NULL);
+
+    return object->name;
+}
+
+// Get the basic reproductive ratio R0 of an infectious agent
+float infectiousAgent_getR0(tInfectiousAgent* object) {
+    // Verify pre conditions
+    assert(object != NULL);
+
+    return object->r0;
+}
+
+// Get the transmission medium of an infectious agent
+const char* infectiousAgent_getMedium(tInfectiousAgent* object) {
+    // Verify pre conditions
+    assert(object != NULL);
+
+    return object->medium;
+}
+
+// Get the date of first infection of an infectious agent
+tDate infectiousAgent_getDate(tInfectiousAgent* object) {
+    // Verify pre conditions
+    assert(object != NULL);
+
+    return object->date;
+}
+
+// Get the city of first infection of an infectious agent
+const char* infectiousAgent_getCity(tInfectiousAgent* object) {
+    // Verify pre conditions
+    assert(object != NULL);
+
+    return object->city;
+}
+
 // Get the reservoirs list of an infectious agent
 tReservoirTable* infectiousAgent_getReservoirs(tInfectiousAgent* object) {
     // Verify pre conditions
@@ -137,6 +264,23 @@ tReservoirTable* infectiousAgent_getReservoirs(tInfectiousAgent* object) {
     return object->reservoirList;
 }
 
+// Get the reservoirs list of an infectious agent to modify it
+tReservoirTable* infectiousAgent_getMutableReservoirs(tInfectiousAgent* object) {
+    tReservoirTable* table;
+
+    // Verify pre conditions
+    assert(object != NULL);
+
+    // Copy on write: if other agents are using the list, the agent gets its own copy before changing it
+    table = reservoirTable_unshare(object->reservoirList);
+    if (table == NULL) {
+        return NULL;
+    }
+    object->reservoirList = table;
+
+    return object->reservoirList;
+}
+
 // Compare two infectious agent
 bool infectiousAgent_equals(tInfectiousAgent* infectiousAgent1, tInfectiousAgent* infectiousAgent2) {
 
@@ -163,9 +307,9 @@ bool infectiousAgent_equals(tInfectiousAgent* infectiousAgent1, tInfectiousAgent
         return false;
     }
 
-    if (infectiousAgent1->date->day != infectiousAgent2->date->day ||
-        infectiousAgent1->date->month != infectiousAgent2->date->month ||
-        infectiousAgent1->date->year != infectiousAgent2->date->year) {
+    if (infectiousAgent1->date.day != infectiousAgent2->date.day ||
+        infectiousAgent1->date.month != infectiousAgent2->date.month ||
+        infectiousAgent1->date.year != infectiousAgent2->date.year) {
         // date of first infection
         return false;
     }
@@ -185,17 +329,171 @@ bool infectiousAgent_equals(tInfectiousAgent* infectiousAgent1, tInfectiousAgent
 
 // Copy the data of a infectious agent to another infectious agent
 tError infectiousAgent_cpy(tInfectiousAgent* dest, tInfectiousAgent* src) {
+    tInfectiousAgent copy;
+    tError err;
+
     // Verify pre conditions
     assert(dest != NULL);
     assert(src != NULL);
 
+    // Copying an agent to itself does not change it
+    if (dest == src) {
+        return OK;
+    }
+
+    // Initialize a new element with the data. The destination is only changed if there is memory for the copy.
+    err = infectiousAgent_init(&copy, src->name, src->r0, src->medium, &src->date, src->city, src->reservoirList);
+    if (err != OK) {
+        return err;
+    }
 
-    // Initialize the element with the new data
-    infectiousAgent_init(dest, src->name, src->r0, src->medium, src->date, src->city, src->reservoirList);
+    // Give back the memory of the previous data of the destination. An empty destination has all its fields NULL, so nothing is freed.
+    infectiousAgent_free(dest);
+    *dest = copy;
 
     return OK;
 }
 
+// Build the hash index of the names. The index stores ids, so it is only built once, when the table becomes big enough.
+static tError infectiousAgentTable_buildIndex(tInfectiousAgentTable* table) {
+    tError err;
+    int i;
+
+    hashIndex_clear(&table->index);
+    err = hashIndex_reserve(&table->index, table->capacity);
+    for (i = 0; i < table->size && err == OK; i++) {
+        // Skip the removed agents
+        if (table->elements[i].name != NULL) {
+            err = hashIndex_put(&table->index, table->elements[i].name, (void*)(intptr_t)(table->ids[i] + 1));
+        }
+    }
+
+    return err;
+}
+
+// Give an id to the agent at a position of the table, reusing the id of a removed agent if there is one
+static unsigned int infectiousAgentTable_newId(tInfectiousAgentTable* table, unsigned int pos) {
+    unsigned int id;
+
+    if (table->freeId != INFECTIOUS_AGENT_NO_ID) {
+        id = table->freeId;
+        table->freeId = table->positions[id];
+    }
+    else {
+        // There are never more ids in use than agents in the table, so the new id fits in the arrays
+        id = table->idCount;
+        table->idCount++;
+    }
+    table->ids[pos] = id;
+    table->positions[id] = pos;
+
+    return id;
+}
+
+// Give back the id of the agent at a position of the table
+static void infectiousAgentTable_freeId(tInfectiousAgentTable* table, unsigned int pos) {
+    unsigned int id;
+
+    id = table->ids[pos];
+    table->positions[id] = table->freeId;
+    table->freeId = id;
+}
+
+// Move the agent at position from to position to, which is free
+static void infectiousAgentTable_move(tInfectiousAgentTable* table, unsigned int from, unsigned int to) {
+    table->elements[to] = table->elements[from];
+    table->ids[to] = table->ids[from];
+    table->positions[table->ids[to]] = to;
+}
+
+// Compare two entries of the index of R0, first by R0 and then by position
+static int r0Index_compare(const void* a, const void* b) {
+    const tR0Entry* entry1 = (const tR0Entry*)a;
+    const tR0Entry* entry2 = (const tR0Entry*)b;
+
+    if (entry1->r0 != entry2->r0) {
+        return (entry1->r0 < entry2->r0) ? -1 : 1;
+    }
+    if (entry1->pos != entry2->pos) {
+        return (entry1->pos < entry2->pos) ? -1 : 1;
+    }
+    return 0;
+}
+
+// Binary search of the first entry of the index of R0 that is not lower than (r0, pos)
+static unsigned int r0Index_lowerBound(tInfectiousAgentTable* table, float r0, unsigned int pos) {
+    unsigned int first, last, middle;
+    tR0Entry* entry;
+
+    first = 0;
+    last = table->r0IndexSize;
+    while (first < last) {
+        middle = first + (last - first) / 2;
+        entry = &table->r0Index[middle];
+        if (entry->r0 < r0 || (entry->r0 == r0 && entry->pos < pos)) {
+            first = middle + 1;
+        }
+        else {
+            last = middle;
+        }
+    }
+
+    return first;
+}
+
+// Add the agent at a position of the table to the index of R0. The index has room for all the agents of the table.
+static void r0Index_insert(tInfectiousAgentTable* table, unsigned int pos) {
+    unsigned int i;
+
+    if (!table->r0IndexValid) {
+        return;
+    }
+
+    i = r0Index_lowerBound(table, table->elements[pos].r0, pos);
+    memmove(&table->r0Index[i + 1], &table->r0Index[i], (table->r0IndexSize - i) * sizeof(tR0Entry));
+    table->r0Index[i].r0 = table->elements[pos].r0;
+    table->r0Index[i].pos = pos;
+    table->r0IndexSize++;
+}
+
+// Remove the entry (r0, pos) from the index of R0
+static void r0Index_delete(tInfectiousAgentTable* table, float r0, unsigned int pos) {
+    unsigned int i;
+
+    if (!table->r0IndexValid) {
+        return;
+    }
+
+    i = r0Index_lowerBound(table, r0, pos);
+    if (i < table->r0IndexSize && table->r0Index[i].pos == pos) {
+        memmove(&table->r0Index[i], &table->r0Index[i + 1], (table->r0IndexSize - i - 1) * sizeof(tR0Entry));
+        table->r0IndexSize--;
+    }
+}
+
+// Sort again the index of R0 if it is not valid
+static void r0Index_build(tInfectiousAgentTable* table) {
+    unsigned int i;
+
+    if (table->r0IndexValid) {
+        return;
+    }
+
+    // Add all the agents that are not removed, and sort them. This costs O(n log n), but it is only done once after many changes.
+    table->r0IndexSize = 0;
+    for (i = 0; i < table->size; i++) {
+        if (table->elements[i].name != NULL) {
+            table->r0Index[table->r0IndexSize].r0 = table->elements[i].r0;
+            table->r0Index[table->r0IndexSize].pos = i;
+            table->r0IndexSize++;
+        }
+    }
+    if (table->r0IndexSize > 1) {
+        qsort(table->r0Index, table->r0IndexSize, sizeof(tR0Entry), r0Index_compare);
+    }
+    table->r0IndexValid = true;
+}
+
 // Initialize the Table of infectious agents
 void infectiousAgentTable_init(tInfectiousAgentTable* table) {
     // Verify pre conditions
@@ -203,9 +501,26 @@ void infectiousAgentTable_init(tInfectiousAgentTable* table) {
 
     // The initialization of a table is to set it to the empty state. That is, with 0 elements. 
     table->size = 0;
+    table->capacity = 0;
     // Using dynamic memory, the pointer to the elements must be set to NULL (no memory allocated).
     // This is the main difference with respect to the infectious agents of static memory, were data was allways initialized (tInfectiousAgent elements[MAX_ELEMENTS])
     table->elements = NULL;
+    // Small tables have no index
+    hashIndex_init(&table->index);
+    table->ids = NULL;
+    table->positions = NULL;
+    table->idCount = 0;
+    table->freeId = INFECTIOUS_AGENT_NO_ID;
+    // Removing an agent keeps the order of the table
+    table->removeMode = REMOVE_SHIFT;
+    table->removed = 0;
+    // The index of R0 is empty, so it is valid
+    table->r0Index = NULL;
+    table->r0IndexSize = 0;
+    table->r0IndexValid = true;
+    // No species are indexed
+    hashIndex_init(&table->species);
+    table->indexedReservoirs = NULL;
 }
 
 // Remove the memory used by infectious agent table structure
@@ -214,143 +529,304 @@ void infectiousAgentTable_free(tInfectiousAgentTable* object) {
     assert(object != NULL);
 
     // All memory allocated with malloc and realloc needs to be freed using the free command.
-    // In this case, as we use malloc/realloc to allocate the elements, and need to free them.
+    // In this case, as we use malloc/realloc to allocate the elements, and need to free them. Removed agents were already freed, and freeing them again does nothing.
     if (object->elements != NULL) {
         for (int i = 0; i < object->size; i++) {
+            if (object->elements[i].name != NULL) {
+                reservoirTable_release(object->indexedReservoirs[object->ids[i]]);
+            }
             infectiousAgent_free(&object->elements[i]);
         }
         free(object->elements);
         object->elements = NULL;
-        // As the table is now empty, assign the size to 0.
-        object->size = 0;
+    }
+    // As the table is now empty, assign the size to 0.
+    object->size = 0;
+    object->capacity = 0;
+    object->removed = 0;
+    hashIndex_free(&object->index);
+    if (object->ids != NULL) {
+        free(object->ids);
+        object->ids = NULL;
+    }
+    if (object->positions != NULL) {
+        free(object->positions);
+        object->positions = NULL;
+    }
+    object->idCount = 0;
+    object->freeId = INFECTIOUS_AGENT_NO_ID;
+
+    if (object->r0Index != NULL) {
+        free(object->r0Index);
+        object->r0Index = NULL;
+    }
+    object->r0IndexSize = 0;
+    object->r0IndexValid = true;
+
+    speciesIndex_free(&object->species);
+    if (object->indexedReservoirs != NULL) {
+        free(object->indexedReservoirs);
+        object->indexedReservoirs = NULL;
+    }
+}
+
+// Make room in the table for at least count infectious agents
+tError infectiousAgentTable_reserve(tInfectiousAgentTable* table, unsigned int count) {
+    unsigned int capacity;
+    tError err;
+
+    // Verify pre conditions
+    assert(table != NULL);
+
+    if (count <= table->capacity) {
+        // There is already enough memory
+        return OK;
     }
 
+    // Grow geometrically (see array_capacity). The index of R0 and the arrays of ids grow with the table. They are resized first, so if the elements cannot grow the table is still consistent.
+    capacity = array_capacity(table->capacity, count, INFECTIOUS_AGENT_TABLE_MIN_CAPACITY);
+    err = array_resize(&table->r0Index, capacity, sizeof(tR0Entry));
+    if (err == OK) {
+        err = array_resize(&table->ids, capacity, sizeof(unsigned int));
+    }
+    if (err == OK) {
+        err = array_resize(&table->positions, capacity, sizeof(unsigned int));
+    }
+    if (err == OK) {
+        err = array_resize(&table->indexedReservoirs, capacity, sizeof(tReservoirTable*));
+    }
+    if (err == OK) {
+        err = array_resize(&table->elements, capacity, sizeof(tInfectiousAgent));
+    }
+    if (err != OK) {
+        return err;
+    }
+    table->capacity = capacity;
+
+    // The index stores ids, so it is still valid if the elements are moved to a new block of memory. It is only built when the table becomes big enough.
+    if (table->index.entries == NULL && capacity >= INFECTIOUS_AGENT_TABLE_INDEX_MIN_SIZE) {
+        return infectiousAgentTable_buildIndex(table);
+    }
 
+    return OK;
 }
 
 // Add a new infectious agent to the table
 tError infectiousAgentTable_add(tInfectiousAgentTable* table, tInfectiousAgent* infectiousAgent) {
+    tInfectiousAgent* element;
+    unsigned int id;
+    tError err;
+
     // Verify pre conditions
     assert(table != NULL);
     assert(infectiousAgent != NULL);
 
-    // Check if reservoirs already is on the table
+    // Check if the infectious agent already is on the table. With the index of names, this is O(1) instead of a scan of the table.
     if (infectiousAgentTable_find(table, infectiousAgent->name))
         return ERR_DUPLICATED;
 
-    // The first step is to allocate the required space. There are two methods to manage the memory (malloc and realloc).
-    // Malloc allows to allocate a new memory block, while realloc allows to modify an existing memory block.    
-    if (table->size == 0) {
-        // Empty table
-
-        // Increase the number of elements of the table
-        table->size = 1;
+    // The first step is to make sure there is space for one more element. The memory block only grows when it is full.
+    err = infectiousAgentTable_reserve(table, table->size + 1);
+    if (err != OK) {
+        return err;
+    }
 
-        // Since the table is empty, and we do not have any previous memory block, we have to use malloc.
-        // The amount of memory we need is the number of elements (will be 1) times the size of one element,
-        // which is computed by sizeof(type). In this case the type is tInfectiousAgent.
-        table->elements = (tInfectiousAgent*)malloc(table->size * sizeof(tInfectiousAgent));
+    // Once we have the block of memory, which is an array of tInfectiousAgent elements, we initialize the new element (which is the last one).
+    // The last element is " table->elements[table->size] " (we start counting at 0)
+    element = &(table->elements[table->size]);
+    err = infectiousAgent_init(element, infectiousAgent->name, infectiousAgent->r0,
+        infectiousAgent->medium, &infectiousAgent->date, infectiousAgent->city, infectiousAgent->reservoirList);
+    if (err != OK) {
+        return err;
     }
-    else {
-        // table with elements
 
-        // Increase the number of elements of the table
-        table->size = table->size + 1;
+    // Increase the number of elements of the table
+    table->size = table->size + 1;
+    id = infectiousAgentTable_newId(table, table->size - 1);
+
+    // Add the agent to the index of R0
+    r0Index_insert(table, table->size - 1);
 
-        // Since the table is not empty, we already have a memory block. We need to modify the size of this block,
-        // using the realloc command. The amount of memory we need is the number of elements times the size of one element,
-        // which is computed by sizeof(type). In this case the type is tInfectiousAgent. We provide the previous block of memory.
-        table->elements = (tInfectiousAgent*)realloc(table->elements, table->size * sizeof(tInfectiousAgent));
+    // Add the name to the index
+    if (table->index.entries != NULL) {
+        err = hashIndex_put(&table->index, element->name, (void*)(intptr_t)(id + 1));
+        if (err != OK) {
+            return err;
+        }
     }
 
-    // Check that the memory has been allocated
-    if (table->elements == NULL) {
-        // Error allocating or reallocating the memory
-        return ERR_MEMORY_ERROR;
+    // Index the species of its reservoirs. The list of the agent is already shared, so sharing it again only counts one more user.
+    table->indexedReservoirs[id] = reservoirTable_share(element->reservoirList);
+    return speciesIndex_add(&table->species, element->name, table->indexedReservoirs[id]);
+}
+
+// Add an array of infectious agents to the table. Agents already in the table or repeated in the array are skipped
+tError infectiousAgentTable_addBulk(tInfectiousAgentTable* table, tInfectiousAgent* infectiousAgents, unsigned int count) {
+    tError err;
+    unsigned int i;
+
+    // Verify pre conditions
+    assert(table != NULL);
+    assert(infectiousAgents != NULL || count == 0);
+
+    // Allocate the memory for all the new elements at once. If the table becomes big enough, the index of names is also built, so each duplicate check is O(1) instead of a scan of the table.
+    err = infectiousAgentTable_reserve(table, table->size + count);
+
+    // Sorting the index of R0 once is cheaper than inserting the agents one by one
+    if (count > 1) {
+        table->r0IndexValid = false;
     }
 
-    // Once we have the block of memory, which is an array of tInfectiousAgent elements, we initialize the new element (which is the last one).
-    // The last element is " table->elements[table->size - 1] " (we start counting at 0)
-    infectiousAgent_init(&(table->elements[table->size - 1]), infectiousAgent->name, infectiousAgent->r0,
-        infectiousAgent->medium, infectiousAgent->date, infectiousAgent->city, infectiousAgent->reservoirList);
+    for (i = 0; i < count && err == OK; i++) {
+        if (infectiousAgentTable_find(table, infectiousAgents[i].name) != NULL) {
+            // Duplicated infectious agent, skip it
+            continue;
+        }
 
-    return OK;
+        // There is room for all the elements, so add cannot move them
+        err = infectiousAgentTable_add(table, &infectiousAgents[i]);
+    }
+
+    return err;
 }
 
 // Remove a infectious agent from the table
 tError infectiousAgentTable_remove(tInfectiousAgentTable* table, tInfectiousAgent* infectiousAgent) {
-    bool found;
+    tInfectiousAgent* element;
+    int i, pos, last;
 
     // Verify pre conditions
     assert(table != NULL);
     assert(infectiousAgent != NULL);
 
-    // To remove an element of a table, we will move all elements after this element one position, 
-    // to fill the space of the removed element.
-    found = false;
-    for (int i = 0; i<table->size; i++) {
-        // If the element has been found. Displace this element to the previous element 
-        // (will never happend for the first one). We use the ADDRESS of the previous element &(table->elements[i-1]) 
-        // as destination, and ADDRESS of the current element &(table->elements[i]) as source.
-        if (found) {
-            // Check the return code to detect memory allocation errors
-            if (infectiousAgent_cpy(&(table->elements[i - 1]), &(table->elements[i])) == ERR_MEMORY_ERROR) {
-                // Error allocating memory. Just stop the process and return memory error.
-                return ERR_MEMORY_ERROR;
-            }
+    element = infectiousAgentTable_find(table, infectiousAgent->name);
+    if (element == NULL) {
+        // If the element was not in the table, return an error.
+        return ERR_NOT_FOUND;
+    }
 
+    // If we are removing the last element, we will free the last/remaining element in table / assign pointer to NULL
+    if (infectiousAgentTable_size(table) <= 1) {
+        infectiousAgentTable_free(table);
+        return OK;
+    }
+
+    // Remove the agent from the indexes while its strings are still allocated. Then free it, which is the only memory released.
+    pos = element - table->elements;
+    r0Index_delete(table, element->r0, pos);
+    speciesIndex_remove(&table->species, element->name, table->indexedReservoirs[table->ids[pos]]);
+    reservoirTable_release(table->indexedReservoirs[table->ids[pos]]);
+    if (table->index.entries != NULL) {
+        hashIndex_remove(&table->index, element->name);
+    }
+    infectiousAgentTable_freeId(table, pos);
+    infectiousAgent_free(element);
+
+    if (table->removeMode == REMOVE_TOMBSTONE) {
+        // The freed agent has a NULL name, which marks it as removed. No element is moved, so the pointers to the other agents are still valid.
+        table->removed++;
+        // Compact when most of the array are gaps, as the table of infections does
+        if (table->removed > table->size / 2) {
+            return infectiousAgentTable_compact(table);
         }
-        else if (strcmp(table->elements[i].name, infectiousAgent->name) == 0) {
-            // The current element is the element we want to remove. Set found flag to true to start element movement.
-            found = true;
-        }
+        return OK;
     }
 
-    // Once removed the element, we need to modify the memory used by the table.
-    if (found) {
-        // If we are removing the last element, we will free 
-        // the last/remaining element in table / assign pointer 
-        // to NULL
-        if (table->size <= 1) {
-            infectiousAgentTable_free(table);
+    // To fill the space of the removed element, the structures are moved as raw memory. The strings and reservoirs of the moved agents belong to them, so they are not copied: no memory is allocated or freed.
+    // The index of names stores ids, so it is not changed: only the positions of the moved agents are updated.
+    if (table->removeMode == REMOVE_SWAP) {
+        // Move the last element to the gap
+        last = table->size - 1;
+        if (pos != last) {
+            r0Index_delete(table, table->elements[last].r0, last);
+            infectiousAgentTable_move(table, last, pos);
+            r0Index_insert(table, pos);
         }
-        else {
-            infectiousAgent_free(&table->elements[table->size - 1]);
-            // Modify the used memory. As we are modifying a previously 
-            // allocated block, we need to use the realloc command.
-            table->elements = (tInfectiousAgent*)realloc(table->elements, table->size * sizeof(tInfectiousAgent));
-
-            // Check that the memory has been allocated
-            if (table->elements == NULL) {
-                // Error allocating or reallocating the memory
-                return ERR_MEMORY_ERROR;
-            }
-            else {
-                // Succesfully allocated, set new table size
-                table->size = table->size - 1;
+    }
+    else {
+        // Move all elements after this element one position
+        memmove(&table->elements[pos], &table->elements[pos + 1], (table->size - pos - 1) * sizeof(tInfectiousAgent));
+        memmove(&table->ids[pos], &table->ids[pos + 1], (table->size - pos - 1) * sizeof(unsigned int));
+        for (i = pos; i < table->size - 1; i++) {
+            table->positions[table->ids[i]] = i;
+        }
+        // The agents after the gap are one position before. Their order in the index of R0 does not change.
+        for (i = 0; i < table->r0IndexSize && table->r0IndexValid; i++) {
+            if (table->r0Index[i].pos > pos) {
+                table->r0Index[i].pos--;
             }
         }
     }
-    else {
-        // If the element was not in the table, return an error.
-        return ERR_NOT_FOUND;
+
+    // The memory block keeps its capacity (see array_capacity)
+    table->size = table->size - 1;
+
+    return OK;
+}
+
+// Set how the gap left by a removed infectious agent is filled. Leaving REMOVE_TOMBSTONE compacts the table
+tError infectiousAgentTable_setRemoveMode(tInfectiousAgentTable* table, tRemoveMode mode) {
+    // Verify pre conditions
+    assert(table != NULL);
+
+    table->removeMode = mode;
+
+    // Only tables in REMOVE_TOMBSTONE mode can have removed agents
+    if (mode != REMOVE_TOMBSTONE) {
+        return infectiousAgentTable_compact(table);
     }
 
     return OK;
+}
+
+// Remove the agents marked as removed from the array, moving the others to fill the gaps. The order of the table is kept
+tError infectiousAgentTable_compact(tInfectiousAgentTable* table) {
+    unsigned int i, last;
+
+    // Verify pre conditions
+    assert(table != NULL);
+
+    if (table->removed == 0) {
+        // There are no gaps
+        return OK;
+    }
 
+    // Go over the table once, moving the agents to the first free position
+    last = 0;
+    for (i = 0; i < table->size; i++) {
+        if (table->elements[i].name != NULL) {
+            infectiousAgentTable_move(table, i, last);
+            last++;
+        }
+    }
+    table->size = last;
+    table->removed = 0;
+
+    // The positions of the agents have changed. The index of names stores ids, so it is still valid.
+    table->r0IndexValid = false;
+
+    return OK;
 }
 
 // Get infectious agent by infectious agent name
 tInfectiousAgent* infectiousAgentTable_find(tInfectiousAgentTable* table, const char* infectiousAgentName) {
+    intptr_t id;
     int i;
 
     // Verify pre conditions
     assert(table != NULL);
     assert(infectiousAgentName != NULL);
 
+    // Big tables have an index of names
+    if (table->index.entries != NULL) {
+        id = (intptr_t)hashIndex_get(&table->index, infectiousAgentName);
+        return (id > 0) ? &table->elements[table->positions[id - 1]] : NULL;
+    }
+
     // Search over the table and return once we found the element.
     for (i = 0; i<table->size; i++) {
-        if (strcmp(table->elements[i].name, infectiousAgentName) == 0) {
+        // Removed agents have no name
+        if (table->elements[i].name != NULL && strcmp(table->elements[i].name, infectiousAgentName) == 0) {
             // We return the ADDRESS (&) of the element, which is a pointer to the element
             return &(table->elements[i]);
         }
@@ -365,16 +841,111 @@ unsigned int infectiousAgentTable_size(tInfectiousAgentTable* table) {
     // Verify pre conditions
     assert(table != NULL);
 
-    return table->size;
+    // The removed agents still in the array are not counted
+    return table->size - table->removed;
+}
+
+// Get the reservoirs of a species and their infectious agents, NULL if no agent of the table has a reservoir of the species
+tSpeciesEntry* infectiousAgentTable_findBySpecies(tInfectiousAgentTable* table, const char* species) {
+    // Verify pre conditions
+    assert(table != NULL);
+    assert(species != NULL);
+
+    return (tSpeciesEntry*)hashIndex_get(&table->species, species);
+}
+
+// Index again the species of an infectious agent of the table, after its reservoirs have been changed
+tError infectiousAgentTable_updateSpecies(tInfectiousAgentTable* table, const char* infectiousAgentName) {
+    tInfectiousAgent* element;
+    unsigned int id;
+
+    // Verify pre conditions
+    assert(table != NULL);
+    assert(infectiousAgentName != NULL);
+
+    element = infectiousAgentTable_find(table, infectiousAgentName);
+    if (element == NULL) {
+        return ERR_NOT_FOUND;
+    }
+
+    id = table->ids[element - table->elements];
+    if (table->indexedReservoirs[id] == element->reservoirList) {
+        // The reservoirs have not changed since they were indexed
+        return OK;
+    }
+
+    speciesIndex_remove(&table->species, element->name, table->indexedReservoirs[id]);
+    reservoirTable_release(table->indexedReservoirs[id]);
+    table->indexedReservoirs[id] = reservoirTable_share(element->reservoirList);
+
+    return speciesIndex_add(&table->species, element->name, table->indexedReservoirs[id]);
+}
+
+// Get the infectious agents with R0 between minR0 and maxR0 (both included), sorted by R0. At most maxResults agents are stored in result. Returns the number of agents stored
+unsigned int infectiousAgentTable_findByR0(tInfectiousAgentTable* table, float minR0, float maxR0, tInfectiousAgent** result, unsigned int maxResults) {
+    unsigned int i, count;
+
+    // Verify pre conditions
+    assert(table != NULL);
+    assert(result != NULL || maxResults == 0);
+
+    r0Index_build(table);
+
+    // Find the first agent with R0 not lower than minR0 with a binary search, O(log n), and then go over the agents until maxR0, O(k)
+    count = 0;
+    for (i = r0Index_lowerBound(table, minR0, 0); i < table->r0IndexSize && table->r0Index[i].r0 <= maxR0 && count < maxResults; i++) {
+        result[count] = &table->elements[table->r0Index[i].pos];
+        count++;
+    }
+
+    return count;
+}
+
+// Get the k infectious agents with the highest R0, from the highest to the lowest. Returns the number of agents stored in result
+unsigned int infectiousAgentTable_topR0(tInfectiousAgentTable* table, unsigned int k, tInfectiousAgent** result) {
+    unsigned int count;
+
+    // Verify pre conditions
+    assert(table != NULL);
+    assert(result != NULL || k == 0);
+
+    r0Index_build(table);
+
+    // The agents with the highest R0 are at the end of the index
+    for (count = 0; count < k && count < table->r0IndexSize; count++) {
+        result[count] = &table->elements[table->r0Index[table->r0IndexSize - 1 - count].pos];
+    }
+
+    return count;
 }
 
 void infectiousAgentTable_print(tInfectiousAgentTable * table) {
+    tWriter writer;
+
+    // Verify pre conditions
+    assert(table != NULL);
+
+    writer_initFile(&writer, stdout);
+    infectiousAgentTable_write(table, &writer);
+    writer_free(&writer);
+}
+
+// Write the table to a writer
+void infectiousAgentTable_write(tInfectiousAgentTable * table, tWriter * writer) {
     // Verify pre conditions
     assert(table != NULL);
+    assert(writer != NULL);
 
     for (int i = 0; i< table->size; i++)   {
-        printf("%s %s \n ", table->elements[i].name, table->elements[i].city);
+        // Skip the removed agents
+        if (table->elements[i].name == NULL) {
+            continue;
+        }
+        writer_putString(writer, table->elements[i].name);
+        writer_putChar(writer, ' ');
+        writer_putString(writer, table->elements[i].city);
+        writer_putString(writer, " \n ");
 
     }
-    printf("\n ");
+    writer_putString(writer, "\n ");
 }
\ No newline at end of file
@@ -0,0 +1,131 @@
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "memPool.h"
+
+// Space used by the header of a chunk, keeping the first allocation aligned
+#define MEM_POOL_HEADER_SIZE (((sizeof(tMemPoolChunk) + MEM_POOL_ALIGN - 1) / MEM_POOL_ALIGN) * MEM_POOL_ALIGN)
+
+// Round a size up to the size of its class, and get the class. Sizes bigger than the last class are only rounded to a multiple of MEM_POOL_ALIGN, and their class is MEM_POOL_CLASSES + MEM_POOL_BIG_CLASSES
+static size_t memPool_class(size_t * size) {
+    size_t classSize, class;
+
+    *size = ((*size + MEM_POOL_ALIGN - 1) / MEM_POOL_ALIGN) * MEM_POOL_ALIGN;
+    if (*size <= MEM_POOL_CLASSES * MEM_POOL_ALIGN) {
+        return *size / MEM_POOL_ALIGN - 1;
+    }
+
+    // Bigger sizes use power of two classes, so a freed block can be reused by any allocation up to twice smaller
+    classSize = 2 * MEM_POOL_CLASSES * MEM_POOL_ALIGN;
+    class = MEM_POOL_CLASSES;
+    while (classSize < *size && class < MEM_POOL_CLASSES + MEM_POOL_BIG_CLASSES) {
+        classSize *= 2;
+        class++;
+    }
+    if (class < MEM_POOL_CLASSES + MEM_POOL_BIG_CLASSES) {
+        *size = classSize;
+    }
+
+    return class;
+}
+
+// Request a new chunk to the system with room for size bytes, and link it to the pool
+static char * memPool_newChunk(tMemPool * pool, size_t size) {
+    tMemPoolChunk * chunk;
+
+    chunk = (tMemPoolChunk*)malloc(MEM_POOL_HEADER_SIZE + size);
+    if (chunk == NULL) {
+        return NULL;
+    }
+    chunk->next = pool->chunks;
+    pool->chunks = chunk;
+
+    return (char*)chunk + MEM_POOL_HEADER_SIZE;
+}
+
+// Initialize an empty pool
+void memPool_init(tMemPool * pool) {
+    // Verify pre conditions
+    assert(pool != NULL);
+
+    pool->chunks = NULL;
+    pool->top = NULL;
+    pool->available = 0;
+    memset(pool->freeBlocks, 0, sizeof(pool->freeBlocks));
+}
+
+// Allocate size bytes from the pool
+void * memPool_alloc(tMemPool * pool, size_t size) {
+    void * ptr;
+    size_t class;
+
+    // Verify pre conditions
+    assert(pool != NULL);
+    assert(size > 0);
+
+    class = memPool_class(&size);
+
+    // Reuse a block given back to the pool
+    if (class < MEM_POOL_CLASSES + MEM_POOL_BIG_CLASSES && pool->freeBlocks[class] != NULL) {
+        ptr = pool->freeBlocks[class];
+        pool->freeBlocks[class] = *(void**)ptr;
+        return ptr;
+    }
+
+    if (size > pool->available) {
+        if (size > MEM_POOL_CHUNK_SIZE / 4) {
+            // Big blocks get their own chunk, so the current chunk can still be used
+            return memPool_newChunk(pool, size);
+        }
+        // The rest of the current chunk is left unused
+        pool->top = memPool_newChunk(pool, MEM_POOL_CHUNK_SIZE);
+        if (pool->top == NULL) {
+            pool->available = 0;
+            return NULL;
+        }
+        pool->available = MEM_POOL_CHUNK_SIZE;
+    }
+
+    // Take the block from the current chunk, just after the previous one
+    ptr = pool->top;
+    pool->top += size;
+    pool->available -= size;
+
+    return ptr;
+}
+
+// Give back a block of size bytes to the pool
+void memPool_free(tMemPool * pool, void * ptr, size_t size) {
+    size_t class;
+
+    // Verify pre conditions
+    assert(pool != NULL);
+    assert(ptr == NULL || size > 0);
+
+    if (ptr == NULL) {
+        return;
+    }
+
+    class = memPool_class(&size);
+    if (class < MEM_POOL_CLASSES + MEM_POOL_BIG_CLASSES) {
+        // Add the block to the list of free blocks of its size
+        *(void**)ptr = pool->freeBlocks[class];
+        pool->freeBlocks[class] = ptr;
+    }
+}
+
+// Give back all the memory of the pool to the system
+void memPool_release(tMemPool * pool) {
+    tMemPoolChunk * chunk;
+
+    // Verify pre conditions
+    assert(pool != NULL);
+
+    while (pool->chunks != NULL) {
+        chunk = pool->chunks;
+        pool->chunks = chunk->next;
+        free(chunk);
+    }
+
+    memPool_init(pool);
+}
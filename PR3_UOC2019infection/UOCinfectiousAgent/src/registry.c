@@ -0,0 +1,242 @@
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "commons.h"
+#include "registry.h"
+
+// Initialize an empty slot array of elements of a given size
+static void slotArray_init(tSlotArray* array, size_t elementSize) {
+    array->elementSize = elementSize;
+    array->chunks = NULL;
+    array->chunkCount = 0;
+    array->chunkCapacity = 0;
+    array->size = 0;
+    array->freeSlots = NULL;
+    array->freeCount = 0;
+    array->freeCapacity = 0;
+}
+
+// Remove the memory of the slot array. The elements must be freed before
+static void slotArray_free(tSlotArray* array) {
+    for (unsigned int i = 0; i < array->chunkCount; i++) {
+        free(array->chunks[i]);
+    }
+    if (array->chunks != NULL) {
+        free(array->chunks);
+    }
+    if (array->freeSlots != NULL) {
+        free(array->freeSlots);
+    }
+    slotArray_init(array, array->elementSize);
+}
+
+// Get the element of a slot
+static void* slotArray_get(tSlotArray* array, unsigned int slot) {
+    return array->chunks[slot / REGISTRY_CHUNK_SIZE] + (slot % REGISTRY_CHUNK_SIZE) * array->elementSize;
+}
+
+// Get a slot for a new element, reusing the slot of a removed element if there is one. The memory of a new slot is filled with zeros. Returns NULL if there is no memory
+static void* slotArray_alloc(tSlotArray* array) {
+    char* chunk;
+
+    if (array->freeCount > 0) {
+        array->freeCount--;
+        return slotArray_get(array, array->freeSlots[array->freeCount]);
+    }
+
+    // Add a chunk when the last one is full. The chunks already allocated are not moved
+    if (array->size == array->chunkCount * REGISTRY_CHUNK_SIZE) {
+        if (array_reserve(&array->chunks, &array->chunkCapacity, array->chunkCount + 1, sizeof(char*), 4) != OK) {
+            return NULL;
+        }
+        chunk = (char*)calloc(REGISTRY_CHUNK_SIZE, array->elementSize);
+        if (chunk == NULL) {
+            return NULL;
+        }
+        array->chunks[array->chunkCount] = chunk;
+        array->chunkCount++;
+    }
+
+    array->size++;
+    return slotArray_get(array, array->size - 1);
+}
+
+// Give back the slot of a removed element
+static tError slotArray_release(tSlotArray* array, void* element) {
+    unsigned int chunk;
+    ptrdiff_t offset;
+    tError err;
+
+    // Find the chunk of the element, to get the number of its slot
+    for (chunk = 0; chunk < array->chunkCount; chunk++) {
+        offset = (char*)element - array->chunks[chunk];
+        if (offset >= 0 && offset < (ptrdiff_t)(REGISTRY_CHUNK_SIZE * array->elementSize)) {
+            break;
+        }
+    }
+    assert(chunk < array->chunkCount);
+
+    err = array_reserve(&array->freeSlots, &array->freeCapacity, array->freeCount + 1, sizeof(unsigned int), 4);
+    if (err != OK) {
+        // The slot is not reused, but the element is still removed
+        return err;
+    }
+    array->freeSlots[array->freeCount] = chunk * REGISTRY_CHUNK_SIZE + (unsigned int)(offset / array->elementSize);
+    array->freeCount++;
+
+    return OK;
+}
+
+// Initialize an empty registry
+void registry_init(tRegistry* registry) {
+    // Verify pre conditions
+    assert(registry != NULL);
+
+    slotArray_init(&registry->agents, sizeof(tInfectiousAgent));
+    hashIndex_init(&registry->agentIndex);
+    slotArray_init(&registry->countries, sizeof(tCountry));
+    hashIndex_init(&registry->countryIndex);
+}
+
+// Remove the memory used by the registry
+void registry_free(tRegistry* registry) {
+    tInfectiousAgent* agent;
+    tCountry* country;
+
+    // Verify pre conditions
+    assert(registry != NULL);
+
+    // The free slots have a NULL name, and freeing them again does nothing
+    for (unsigned int i = 0; i < registry->agents.size; i++) {
+        agent = (tInfectiousAgent*)slotArray_get(&registry->agents, i);
+        infectiousAgent_free(agent);
+    }
+    for (unsigned int i = 0; i < registry->countries.size; i++) {
+        country = (tCountry*)slotArray_get(&registry->countries, i);
+        country_free(country);
+    }
+
+    hashIndex_free(&registry->agentIndex);
+    hashIndex_free(&registry->countryIndex);
+    slotArray_free(&registry->agents);
+    slotArray_free(&registry->countries);
+}
+
+// Add a copy of an infectious agent to the registry
+tError registry_addAgent(tRegistry* registry, tInfectiousAgent* infectiousAgent) {
+    tInfectiousAgent* agent;
+    tError err;
+
+    // Verify pre conditions
+    assert(registry != NULL);
+    assert(infectiousAgent != NULL);
+
+    if (registry_findAgent(registry, infectiousAgent->name) != NULL) {
+        return ERR_DUPLICATED;
+    }
+
+    // New and free slots are empty (all the fields NULL), as infectiousAgent_cpy requires
+    agent = (tInfectiousAgent*)slotArray_alloc(&registry->agents);
+    if (agent == NULL) {
+        return ERR_MEMORY_ERROR;
+    }
+    err = infectiousAgent_cpy(agent, infectiousAgent);
+    if (err == OK) {
+        // The key is the name of the copy, which does not move either
+        err = hashIndex_put(&registry->agentIndex, agent->name, agent);
+    }
+    if (err != OK) {
+        infectiousAgent_free(agent);
+        slotArray_release(&registry->agents, agent);
+    }
+
+    return err;
+}
+
+// Get the copy of an infectious agent in the registry
+tInfectiousAgent* registry_findAgent(tRegistry* registry, const char* infectiousAgentName) {
+    // Verify pre conditions
+    assert(registry != NULL);
+    assert(infectiousAgentName != NULL);
+
+    return (tInfectiousAgent*)hashIndex_get(&registry->agentIndex, infectiousAgentName);
+}
+
+// Remove an infectious agent from the registry
+tError registry_removeAgent(tRegistry* registry, const char* infectiousAgentName) {
+    tInfectiousAgent* agent;
+
+    // Verify pre conditions
+    assert(registry != NULL);
+    assert(infectiousAgentName != NULL);
+
+    agent = registry_findAgent(registry, infectiousAgentName);
+    if (agent == NULL) {
+        return ERR_NOT_FOUND;
+    }
+
+    // The other agents are not moved, so the handles that borrow them are still valid
+    hashIndex_remove(&registry->agentIndex, agent->name);
+    infectiousAgent_free(agent);
+
+    return slotArray_release(&registry->agents, agent);
+}
+
+// Add a copy of a country to the registry
+tError registry_addCountry(tRegistry* registry, tCountry* country) {
+    tCountry* copy;
+    tError err;
+
+    // Verify pre conditions
+    assert(registry != NULL);
+    assert(country != NULL);
+
+    if (registry_findCountry(registry, country->name) != NULL) {
+        return ERR_DUPLICATED;
+    }
+
+    // The list of cities of the copy keeps the address of the country to tell it about collapses, so the country must not move
+    copy = (tCountry*)slotArray_alloc(&registry->countries);
+    if (copy == NULL) {
+        return ERR_MEMORY_ERROR;
+    }
+    err = country_cpy(copy, country);
+    if (err == OK) {
+        err = hashIndex_put(&registry->countryIndex, copy->name, copy);
+    }
+    if (err != OK) {
+        country_free(copy);
+        slotArray_release(&registry->countries, copy);
+    }
+
+    return err;
+}
+
+// Get the copy of a country in the registry
+tCountry* registry_findCountry(tRegistry* registry, const char* countryName) {
+    // Verify pre conditions
+    assert(registry != NULL);
+    assert(countryName != NULL);
+
+    return (tCountry*)hashIndex_get(&registry->countryIndex, countryName);
+}
+
+// Remove a country from the registry
+tError registry_removeCountry(tRegistry* registry, const char* countryName) {
+    tCountry* country;
+
+    // Verify pre conditions
+    assert(registry != NULL);
+    assert(countryName != NULL);
+
+    country = registry_findCountry(registry, countryName);
+    if (country == NULL) {
+        return ERR_NOT_FOUND;
+    }
+
+    // The other countries are not moved, so the handles that borrow them are still valid
+    hashIndex_remove(&registry->countryIndex, country->name);
+    country_free(country);
+
+    return slotArray_release(&registry->countries, country);
+}
@@ -12,6 +12,8 @@
 
 // Creates a research element out of a country and a stats
 tError research_init(tResearch* object, tCountry* country) {
+    tCityTotals totals;
+
     // PR3_EX1
 
     // Verify pre conditions
@@ -26,10 +28,11 @@ tError research_init(tResearch* object, tCountry* country) {
         return ERR_MEMORY_ERROR;
     }
 
-    // Once the memory is allocated, copy the data.
-    object->stats.Infectivity = country_totalCases(country);
-    object->stats.Severity    = country_totalCriticalCases(country);
-    object->stats.Lethality   = country_totalDeaths(country);
+    // Once the memory is allocated, copy the data. All the totals are calculated with a single pass over the cities.
+    totals = country_totals(country);
+    object->stats.Infectivity = totals.cases;
+    object->stats.Severity    = totals.critical_cases;
+    object->stats.Lethality   = totals.deaths;
 
     country_cpy(object->country, country);
 
@@ -398,21 +401,41 @@ tError researchList_bubbleSort(tResearchList *list) {
 
 // Helper function, print list contents
 void researchList_print(tResearchList list) {
+    tWriter writer;
+
+    writer_initFile(&writer, stdout);
+    researchList_write(&list, &writer);
+    writer_free(&writer);
+}
+
+// Write the list contents to a writer
+void researchList_write(tResearchList* list, tWriter* writer) {
     tResearchListNode *pLNode;
+    int i = 0;
 
-    printf("===== List Contents:\n\n");
+    // Verify pre conditions
+    assert(list != NULL);
+    assert(writer != NULL);
 
-    for (int i = 0; i < list.size; i++) {
-        pLNode = researchList_get(&list, i + 1);
-        printf("\tElemPos: %d:\tInfectivity: %d;\tSeverity: %d;\tLethality: %d;\tCountry_Name: \"%s\"\n",
-            i + 1,
-            pLNode->e->stats.Infectivity,
-            pLNode->e->stats.Severity,
-            pLNode->e->stats.Lethality,
-            pLNode->e->country->name
-            );
+    writer_putString(writer, "===== List Contents:\n\n");
 
+    // Follow the links of the list, instead of getting each position from the start
+    for (pLNode = list->first; pLNode != NULL; pLNode = pLNode->next) {
+        i++;
+        writer_putString(writer, "\tElemPos: ");
+        writer_putLong(writer, i);
+        writer_putString(writer, ":\tInfectivity: ");
+        writer_putULong(writer, pLNode->e->stats.Infectivity);
+        writer_putString(writer, ";\tSeverity: ");
+        writer_putULong(writer, pLNode->e->stats.Severity);
+        writer_putString(writer, ";\tLethality: ");
+        writer_putULong(writer, pLNode->e->stats.Lethality);
+        writer_putString(writer, ";\tCountry_Name: \"");
+        writer_putString(writer, pLNode->e->country->name);
+        writer_putString(writer, "\"\n");
     }
 
-    printf("\n===== End Of List: %d elems\n", list.size);
+    writer_putString(writer, "\n===== End Of List: ");
+    writer_putLong(writer, list->size);
+    writer_putString(writer, " elems\n");
 }
@@ -2,8 +2,12 @@
 #include <string.h>
 #include <assert.h>
 #include "reservoir.h"
+#include "stringPool.h"
 #include <stdio.h>
 
+// Number of elements allocated the first time a reservoir is added to an empty table
+#define RESERVOIR_TABLE_MIN_CAPACITY 4
+
 // Initialize the reservoir structure
 tError reservoir_init(tReservoir* object, const char* name, const char* species) {
 
@@ -12,9 +16,9 @@ tError reservoir_init(tReservoir* object, const char* name, const char* species)
     assert(name != NULL);
     assert(species != NULL);
 
-    // Allocate the memory for all the fields, using the length of the provided text plus 1 space for the "end of string" char '\0'. To allocate memory we use the malloc command.
-    object->name = (char*)malloc((strlen(name) + 1) * sizeof(char));
-    object->species = (char*)malloc((strlen(species) + 1) * sizeof(char));
+    // Many reservoirs share the same names and species, so the strings are taken from the string pool instead of allocating a private copy. Equal strings share the same memory.
+    object->name = (char*)stringPool_intern(name);
+    object->species = (char*)stringPool_intern(species);
 
     // Check that memory has been allocated for all fields. Pointer must be different from NULL.
     if (object->name == NULL || object->species == NULL) {
@@ -22,10 +26,6 @@ tError reservoir_init(tReservoir* object, const char* name, const char* species)
         return ERR_MEMORY_ERROR;
     }
 
-    // Once the memory is allocated, copy the data. As the fields are strings, we need to use the string copy function strcpy. 
-    strcpy(object->name, name);
-    strcpy(object->species, species);
-
     return OK;
 }
 
@@ -35,13 +35,13 @@ void reservoir_free(tReservoir* object) {
     // Verify pre conditions
     assert(object != NULL);
 
-    // All memory allocated with malloc and realloc needs to be freed using the free command. In this case, as we use malloc to allocate the fields, we have to free them
+    // The strings are shared, so they are given back to the string pool instead of using the free command. The pool frees them when they are not used anymore.
     if (object->name != NULL) {
-        free(object->name);
+        stringPool_release(object->name);
         object->name = NULL;
     }
     if (object->species != NULL) {
-        free(object->species);
+        stringPool_release(object->species);
         object->species = NULL;
     }
 }
@@ -54,14 +54,14 @@ bool reservoir_equals(tReservoir* reservoir1, tReservoir* reservoir2) {
     assert(reservoir2 != NULL);
 
     // To see if two reservoirs are equals, we need to see ALL the values for their fields are equals.    
-    // Strings are pointers to a table of chars, therefore, cannot be compared  as  " reservoir1->reservoirname == reservoir2->reservoirname ". We need to use a string comparison function    
+    // The strings come from the string pool, where equal strings share the same memory. Therefore, they can be compared as " reservoir1->name == reservoir2->name ", without a string comparison function.
 
-    if (strcmp(reservoir1->name, reservoir2->name) != 0) {
+    if (reservoir1->name != reservoir2->name) {
         // names are different
         return false;
     }
 
-    if (strcmp(reservoir1->species, reservoir2->species) != 0) {
+    if (reservoir1->species != reservoir2->species) {
         // species are different
         return false;
     }
@@ -72,6 +72,9 @@ bool reservoir_equals(tReservoir* reservoir1, tReservoir* reservoir2) {
 
 // Compare two Table of reservoirs. There are equals if they have the same number of reservoir, they have the same reservoirname. The order of reservoirs of two tables could be different
 bool reservoirTable_equals(tReservoirTable* reservoirTable1, tReservoirTable* reservoirTable2){
+    tReservoirTable* indexed;
+    tReservoirTable* other;
+
     // Verify pre conditions
     assert(reservoirTable1 != NULL);
     assert(reservoirTable2 != NULL);
@@ -81,10 +84,26 @@ bool reservoirTable_equals(tReservoirTable* reservoirTable1, tReservoirTable* re
         return false;
     }
 
-    for (i = 0; i< reservoirTable1->size; i++)
+    // Agents can share the same table
+    if (reservoirTable1 == reservoirTable2) {
+        return true;
+    }
+
+    // Names are unique in a table, so both tables are equals if all the names of one of them are in the other one.
+    // The lookups are done on the table with a hash index (if any), so each one is O(1) and the comparison is linear.
+    if (reservoirTable1->index.entries == NULL && reservoirTable2->index.entries != NULL) {
+        indexed = reservoirTable2;
+        other = reservoirTable1;
+    }
+    else {
+        indexed = reservoirTable1;
+        other = reservoirTable2;
+    }
+
+    for (i = 0; i< other->size; i++)
     {
         // Uses "find" because the order of reservoirs could be different
-        if (!reservoirTable_find(reservoirTable1, reservoirTable2->elements[i].name)) {
+        if (!reservoirTable_find(indexed, other->elements[i].name)) {
             // names are different
             return false;
         }
@@ -109,6 +128,20 @@ tError reservoir_cpy(tReservoir* dst, tReservoir* src) {
     return OK;
 }
 
+// Build again the hash index of the names. The index stores the address of the elements, so it must be built again each time they are moved.
+static tError reservoirTable_reindex(tReservoirTable* table) {
+    tError err;
+    int i;
+
+    hashIndex_clear(&table->index);
+    err = hashIndex_reserve(&table->index, table->capacity);
+    for (i = 0; i < table->size && err == OK; i++) {
+        err = hashIndex_put(&table->index, table->elements[i].name, &table->elements[i]);
+    }
+
+    return err;
+}
+
 // Initialize the table of reservoirs
 void reservoirTable_init(tReservoirTable* table) {
     // Verify pre conditions
@@ -116,8 +149,24 @@ void reservoirTable_init(tReservoirTable* table) {
 
     // The initialization of a table is to set it to the empty state. That is, with 0 elements. 
     table->size = 0;
+    table->capacity = 0;
     // Using dynamic memory, the pointer to the elements must be set to NULL (no memory allocated). This is the main difference with respect to the reservoir of static memory, were data was allways initialized (tReservoir elements[MAX_ELEMENTS])
     table->elements = NULL;
+    // Small tables have no index
+    hashIndex_init(&table->index);
+    // Removing a reservoir keeps the order of the table
+    table->removeMode = REMOVE_SHIFT;
+    // The table is owned by the user, not shared
+    table->refs = 0;
+    table->shared = NULL;
+}
+
+// Give back the shared copy of a table owned by the user, before the table changes
+static void reservoirTable_changing(tReservoirTable* table) {
+    if (table->shared != NULL) {
+        reservoirTable_release(table->shared);
+        table->shared = NULL;
+    }
 }
 
 // Remove the memory used by reservoirTable structure
@@ -137,109 +186,231 @@ void reservoirTable_free(tReservoirTable* object) {
     }
     // As the table is now empty, assign the size to 0.
     object->size = 0;
+    object->capacity = 0;
+    hashIndex_free(&object->index);
+    reservoirTable_changing(object);
+}
+
+// Make room in the table for at least count reservoirs
+tError reservoirTable_reserve(tReservoirTable* table, unsigned int count) {
+    unsigned int capacity;
+    tError err;
+
+    // Verify pre conditions
+    assert(table != NULL);
+    // Shared tables are read only
+    assert(table->refs <= 1);
+
+    if (count <= table->capacity) {
+        // There is already enough memory
+        return OK;
+    }
+
+    // Grow geometrically (see array_capacity). On error the elements are not changed.
+    capacity = array_capacity(table->capacity, count, RESERVOIR_TABLE_MIN_CAPACITY);
+    err = array_resize(&table->elements, capacity, sizeof(tReservoir));
+    if (err != OK) {
+        return err;
+    }
+    table->capacity = capacity;
+
+    // The elements could have been moved to a new block of memory. If the table has to be indexed, build the index for the new addresses.
+    if (table->index.entries != NULL || capacity >= RESERVOIR_TABLE_INDEX_MIN_SIZE) {
+        return reservoirTable_reindex(table);
+    }
+
+    return OK;
 }
 
 // Add a new reservoir to the table
 tError reservoirTable_add(tReservoirTable* table, tReservoir* reservoir) {
+    tError err;
+
     // Verify pre conditions
     assert(table != NULL);
     assert(reservoir != NULL);
+    // Shared tables are read only
+    assert(table->refs <= 1);
 
     // Check if reservoirs already is on the table
     if (reservoirTable_find(table, reservoir->name))
         return ERR_DUPLICATED;
 
-    // The first step is to allocate the required space. There are two methods to manage the memory (malloc and realloc). Malloc allows to allocate a new memory block, while realloc allows to modify an existing memory block.    
-    if (table->size == 0) {
-        // Empty table
+    // The agents already using the table keep its previous shared copy
+    reservoirTable_changing(table);
 
-        // Increase the number of elements of the table
-        table->size = 1;
+    // The first step is to make sure there is space for one more element. The memory block only grows when it is full.
+    err = reservoirTable_reserve(table, table->size + 1);
+    if (err != OK) {
+        return err;
+    }
 
-        // Since the table is empty, and we do not have any previous memory block, we have to use malloc. The amount of memory we need is the number of elements (will be 1) times the size of one element, which is computed by sizeof(type). In this case the type is tReservoir.
-        table->elements = (tReservoir*)malloc(table->size * sizeof(tReservoir));
+    // Once we have the block of memory, which is an array of tReservoir elements, we initialize the new element (which is the last one). The last element is " table->elements[table->size] " (we start counting at 0)
+    err = reservoir_init(&(table->elements[table->size]), reservoir->name, reservoir->species);
+    if (err != OK) {
+        return err;
     }
-    else {
-        // table with elements
 
-        // Increase the number of elements of the table
-        table->size = table->size + 1;
+    // Increase the number of elements of the table
+    table->size = table->size + 1;
 
-        // Since the table is not empty, we already have a memory block. We need to modify the size of this block, using the realloc command. The amount of memory we need is the number of elements times the size of one element, which is computed by sizeof(type). In this case the type is tReservoir. We provide the previous block of memory.
-        table->elements = (tReservoir*)realloc(table->elements, table->size * sizeof(tReservoir));
+    // Add the name to the index
+    if (table->index.entries != NULL) {
+        return hashIndex_put(&table->index, table->elements[table->size - 1].name, &table->elements[table->size - 1]);
     }
 
-    // Check that the memory has been allocated
-    if (table->elements == NULL) {
-        // Error allocating or reallocating the memory
-        return ERR_MEMORY_ERROR;
-    }
+    return OK;
+}
 
-    // Once we have the block of memory, which is an array of tReservoir elements, we initialize the new element (which is the last one). The last element is " table->elements[table->size - 1] " (we start counting at 0)
-    reservoir_init(&(table->elements[table->size - 1]), reservoir->name, reservoir->species);
+// Add an array of reservoirs to the table. Reservoirs already in the table or repeated in the array are skipped
+tError reservoirTable_addBulk(tReservoirTable* table, tReservoir* reservoirs, unsigned int count) {
+    tError err;
+    unsigned int i;
 
-    return OK;
+    // Verify pre conditions
+    assert(table != NULL);
+    assert(reservoirs != NULL || count == 0);
+
+    // Allocate the memory for all the new elements at once. If the table becomes big enough, the index of names is also built, so each duplicate check is O(1) instead of a scan of the table.
+    err = reservoirTable_reserve(table, table->size + count);
+
+    for (i = 0; i < count && err == OK; i++) {
+        if (reservoirTable_find(table, reservoirs[i].name) != NULL) {
+            // Duplicated reservoir, skip it
+            continue;
+        }
+
+        // There is room for all the elements, so add cannot move them
+        err = reservoirTable_add(table, &reservoirs[i]);
+    }
+
+    return err;
 }
 
 // Remove a reservoir from the table
 tError reservoirTable_remove(tReservoirTable * table, tReservoir * reservoir) {
-    int i;
-    bool found;
+    tReservoir* element;
+    int i, pos;
 
     // Verify pre conditions
     assert(table != NULL);
     assert(reservoir != NULL);
+    // Shared tables are read only
+    assert(table->refs <= 1);
 
-    // To remove an element of a table, we will move all elements after this element one position, to fill the space of the removed element.
-    found = false;
-    for (i = 0; i < table->size; i++) {
-        // If the element has been found. Displace this element to the previous element (will never happend for the first one). We use the ADDRESS of the previous element &(table->elements[i-1]) as destination, and ADDRESS of the current element &(table->elements[i]) as source.
-        if (found) {
-            // Check the return code to detect memory allocation errors
-            if (reservoir_cpy(&(table->elements[i - 1]), &(table->elements[i])) == ERR_MEMORY_ERROR) {
-                // Error allocating memory. Just stop the process and return memory error.
+    element = reservoirTable_find(table, reservoir->name);
+    if (element == NULL) {
+        // If the element was not in the table, return an error.
+        return ERR_NOT_FOUND;
+    }
+
+    // The agents already using the table keep its previous shared copy
+    reservoirTable_changing(table);
+
+    // If we are removing the last element, we will free the last/remaining element in table / assign pointer to NULL
+    if (table->size <= 1) {
+        reservoirTable_free(table);
+        return OK;
+    }
+
+    // Remove the name from the index while the string is still allocated, and free the element
+    pos = element - table->elements;
+    if (table->index.entries != NULL) {
+        hashIndex_remove(&table->index, element->name);
+    }
+    reservoir_free(element);
+
+    // To fill the space of the removed element, the structures are moved as raw memory. The strings of the moved elements are not copied, so no memory is allocated or freed.
+    if (table->removeMode == REMOVE_SWAP) {
+        // Move the last element to the gap
+        if (pos != table->size - 1) {
+            table->elements[pos] = table->elements[table->size - 1];
+            if (table->index.entries != NULL && hashIndex_put(&table->index, table->elements[pos].name, &table->elements[pos]) != OK) {
                 return ERR_MEMORY_ERROR;
             }
-
         }
-        else if (strcmp(table->elements[i].name, reservoir->name) == 0) {
-            // The current element is the element we want to remove. Set found flag to true to start element movement.
-            found = true;
+    }
+    else {
+        // Move all elements after this element one position
+        memmove(&table->elements[pos], &table->elements[pos + 1], (table->size - pos - 1) * sizeof(tReservoir));
+        for (i = pos; i < table->size - 1 && table->index.entries != NULL; i++) {
+            if (hashIndex_put(&table->index, table->elements[i].name, &table->elements[i]) != OK) {
+                return ERR_MEMORY_ERROR;
+            }
         }
     }
 
-    // Once removed the element, we need to modify the memory used by the table.
-    if (found) {
-        // If we are removing the last element, we will free 
-        // the last/remaining element in table / assign pointer 
-        // to NULL
-        if (table->size <= 1) {
-            reservoirTable_free(table);
+    // The memory block is kept, so the next additions can reuse it
+    table->size = table->size - 1;
+
+    return OK;
+}
+
+// Remove an array of reservoirs from the table in a single pass. Returns ERR_NOT_FOUND if some of them were not in the table
+tError reservoirTable_removeMany(tReservoirTable* table, tReservoir* reservoirs, unsigned int count) {
+    tHashIndex names;
+    tError err;
+    unsigned int i, last, removed;
+
+    // Verify pre conditions
+    assert(table != NULL);
+    assert(reservoirs != NULL || count == 0);
+    // Shared tables are read only
+    assert(table->refs <= 1);
+
+    // The agents already using the table keep its previous shared copy
+    reservoirTable_changing(table);
+
+    // Put the names to remove in a hash index, so we can check each element of the table in O(1)
+    hashIndex_init(&names);
+    err = hashIndex_reserve(&names, count);
+    for (i = 0; i < count && err == OK; i++) {
+        err = hashIndex_put(&names, reservoirs[i].name, &reservoirs[i]);
+    }
+    if (err != OK) {
+        hashIndex_free(&names);
+        return err;
+    }
+
+    // Go over the table once, freeing the removed elements and moving the kept ones to the first free position. This keeps the order of the table whatever the remove mode is.
+    last = 0;
+    for (i = 0; i < table->size; i++) {
+        if (hashIndex_get(&names, table->elements[i].name) != NULL) {
+            reservoir_free(&table->elements[i]);
         }
         else {
-            reservoir_free(&table->elements[table->size - 1]);
-            // Modify the used memory. As we are modifying a previously 
-            // allocated block, we need to use the realloc command.
-            table->elements = (tReservoir*)realloc(table->elements, table->size * sizeof(tReservoir));
-
-            // Check that the memory has been allocated
-            if (table->elements == NULL) {
-                // Error allocating or reallocating the memory
-                return ERR_MEMORY_ERROR;
-            }
-            else {
-                // Succesfully allocated, set new table size
-                table->size = table->size - 1;
-            }
+            table->elements[last] = table->elements[i];
+            last++;
         }
     }
-    else {
-        // If the element was not in the table, return an error.
-        return ERR_NOT_FOUND;
+    removed = table->size - last;
+    table->size = last;
+
+    // Release the memory when the table is empty, or update the index with the new addresses
+    if (table->size == 0) {
+        reservoirTable_free(table);
+    }
+    else if (removed > 0 && table->index.entries != NULL) {
+        err = reservoirTable_reindex(table);
     }
 
-    return OK;
+    // If some of the reservoirs were not in the table, return an error. The names of the array could be repeated, so they are counted in the index.
+    if (err == OK && removed < names.size) {
+        err = ERR_NOT_FOUND;
+    }
+    hashIndex_free(&names);
+
+    return err;
+}
+
+// Set how the gap left by a removed reservoir is filled
+void reservoirTable_setRemoveMode(tReservoirTable* table, tRemoveMode mode) {
+    // Verify pre conditions
+    assert(table != NULL);
+    // Reservoir tables are small, marking removed elements is only available for infectious agent tables
+    assert(mode != REMOVE_TOMBSTONE);
 
+    table->removeMode = mode;
 }
 
 // Get reservoir by reservoirname
@@ -250,6 +421,11 @@ tReservoir* reservoirTable_find(tReservoirTable* table, const char* name) {
     assert(table != NULL);
     assert(name != NULL);
 
+    // Big tables are indexed by name
+    if (table->index.entries != NULL) {
+        return (tReservoir*)hashIndex_get(&table->index, name);
+    }
+
     // Search over the table and return once we found the element.
     for (i = 0; i<table->size; i++) {
         if (strcmp(table->elements[i].name, name) == 0) {
@@ -262,6 +438,81 @@ tReservoir* reservoirTable_find(tReservoirTable* table, const char* name) {
     return NULL;
 }
 
+// Make a shared copy of a table, with one user
+static tReservoirTable* reservoirTable_clone(tReservoirTable* table) {
+    tReservoirTable* shared;
+
+    shared = (tReservoirTable*)malloc(sizeof(tReservoirTable));
+    if (shared == NULL) {
+        return NULL;
+    }
+    reservoirTable_init(shared);
+    if (reservoirTable_addBulk(shared, table->elements, table->size) != OK) {
+        reservoirTable_free(shared);
+        free(shared);
+        return NULL;
+    }
+    shared->refs = 1;
+
+    return shared;
+}
+
+// Get a shared, read only, version of the table. Shared tables are returned with one more user. Tables owned by the user are copied only once, until they change
+tReservoirTable* reservoirTable_share(tReservoirTable* table) {
+    // Verify pre conditions
+    assert(table != NULL);
+
+    // The table is already shared, just count one more user
+    if (table->refs > 0) {
+        table->refs++;
+        return table;
+    }
+
+    // The table is owned by the user, who could change it. The first time, make a copy that will be shared from now on. The user table keeps it as one more user, so the next agents initialized with the same table just share it.
+    if (table->shared == NULL) {
+        table->shared = reservoirTable_clone(table);
+        if (table->shared == NULL) {
+            return NULL;
+        }
+    }
+
+    return reservoirTable_share(table->shared);
+}
+
+// Get a version of a shared table that can be modified. If other users share the table, a copy is returned and the table is given back
+tReservoirTable* reservoirTable_unshare(tReservoirTable* table) {
+    tReservoirTable* copy;
+
+    // Verify pre conditions
+    assert(table != NULL);
+    assert(table->refs > 0);
+
+    // We are the only user, so the table can be modified
+    if (table->refs == 1) {
+        return table;
+    }
+
+    copy = reservoirTable_clone(table);
+    if (copy != NULL) {
+        reservoirTable_release(table);
+    }
+
+    return copy;
+}
+
+// Give back a shared table. It is freed when nobody else uses it
+void reservoirTable_release(tReservoirTable* table) {
+    // Verify pre conditions
+    assert(table != NULL);
+    assert(table->refs > 0);
+
+    table->refs--;
+    if (table->refs == 0) {
+        reservoirTable_free(table);
+        free(table);
+    }
+}
+
 // Get the size of a the table
 unsigned int reservoirTable_size(tReservoirTable* table) {
     // Verify pre conditions
@@ -272,12 +523,28 @@ unsigned int reservoirTable_size(tReservoirTable* table) {
 }
 
 void reservoirTable_print(tReservoirTable * table) {
+    tWriter writer;
+
+    // Verify pre conditions
+    assert(table != NULL);
+
+    writer_initFile(&writer, stdout);
+    reservoirTable_write(table, &writer);
+    writer_free(&writer);
+}
+
+// Write the table to a writer
+void reservoirTable_write(tReservoirTable * table, tWriter * writer) {
     // Verify pre conditions
     assert(table != NULL);
+    assert(writer != NULL);
 
     for (int i = 0; i< table->size; i++)   {
-        printf("%s %s \n ", table->elements[i].name, table->elements[i].species);
+        writer_putString(writer, table->elements[i].name);
+        writer_putChar(writer, ' ');
+        writer_putString(writer, table->elements[i].species);
+        writer_putString(writer, " \n ");
 
     }
-    printf("\n ");
+    writer_putString(writer, "\n ");
 }
\ No newline at end of file
@@ -0,0 +1,76 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+#include <assert.h>
+#include "stringPool.h"
+#include "hash.h"
+
+// Definition of a shared string. The characters are stored in the same block of memory as the counter
+typedef struct {
+    unsigned int refs;  // Number of users of the string
+    char str[];         // The string itself, with its "end of string" char '\0'
+} tPoolString;
+
+// Index from the text of the strings to their tPoolString. The keys are the strings stored in the pool.
+// There is no lock: the index and the counters are changed without synchronization, so the pool can only be used by one thread at a time. The parallel partitions of groupBy only read strings that are already in the pool.
+static tHashIndex pool = { 0, 0, NULL };
+
+// Get the shared copy of a string, adding it to the pool if needed. Returns NULL if there is no memory
+const char* stringPool_intern(const char* str) {
+    tPoolString* shared;
+    size_t length;
+
+    // Verify pre conditions
+    assert(str != NULL);
+
+    // If the string is already in the pool, just count one more user
+    shared = (tPoolString*)hashIndex_get(&pool, str);
+    if (shared != NULL) {
+        shared->refs++;
+        return shared->str;
+    }
+
+    // Allocate the counter and the characters in a single block, using the length of the text plus 1 space for the "end of string" char '\0'
+    length = strlen(str);
+    shared = (tPoolString*)malloc(sizeof(tPoolString) + (length + 1) * sizeof(char));
+    if (shared == NULL) {
+        return NULL;
+    }
+    memcpy(shared->str, str, (length + 1) * sizeof(char));
+    shared->refs = 1;
+
+    if (hashIndex_put(&pool, shared->str, shared) != OK) {
+        free(shared);
+        return NULL;
+    }
+
+    return shared->str;
+}
+
+// Give back a shared string. It is freed when nobody else uses it
+void stringPool_release(const char* str) {
+    tPoolString* shared;
+
+    // Verify pre conditions
+    assert(str != NULL);
+
+    // The string is stored just after its counter, so we can get the counter from the address of the string without searching the pool
+    shared = (tPoolString*)(str - offsetof(tPoolString, str));
+    assert(shared->refs > 0);
+
+    shared->refs--;
+    if (shared->refs == 0) {
+        hashIndex_remove(&pool, shared->str);
+        free(shared);
+
+        // Release the index when the pool is empty
+        if (pool.size == 0) {
+            hashIndex_free(&pool);
+        }
+    }
+}
+
+// Get the number of different strings in the pool
+unsigned int stringPool_size() {
+    return pool.size;
+}
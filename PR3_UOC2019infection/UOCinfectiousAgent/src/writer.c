@@ -0,0 +1,259 @@
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <unistd.h>
+#include "writer.h"
+#include "commons.h"
+
+// Initial size of the buffer of memory writers
+#define WRITER_MIN_CAPACITY 256
+
+// Pairs of digits from "00" to "99", so numbers are formatted two digits at a time
+static const char writer_digits[] =
+    "0001020304050607080910111213141516171819"
+    "2021222324252627282930313233343536373839"
+    "4041424344454647484950515253545556575859"
+    "6061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+// Initialize the fields shared by all the writers
+static tError writer_init(tWriter * writer, tWriterTarget target, unsigned int capacity) {
+    writer->target = target;
+    writer->file = NULL;
+    writer->fd = -1;
+    writer->size = 0;
+    writer->capacity = capacity;
+    writer->error = OK;
+    writer->buffer = NULL;
+    if (capacity > 0) {
+        writer->buffer = (char*)malloc(capacity * sizeof(char));
+        if (writer->buffer == NULL) {
+            writer->capacity = 0;
+            writer->error = ERR_MEMORY_ERROR;
+        }
+    }
+
+    return writer->error;
+}
+
+// Initialize a writer to a FILE*
+tError writer_initFile(tWriter * writer, FILE * file) {
+    // Verify pre conditions
+    assert(writer != NULL);
+    assert(file != NULL);
+
+    writer_init(writer, WRITER_FILE, WRITER_BUFFER_SIZE);
+    writer->file = file;
+
+    return writer->error;
+}
+
+// Initialize a writer to a file descriptor
+tError writer_initFd(tWriter * writer, int fd) {
+    // Verify pre conditions
+    assert(writer != NULL);
+    assert(fd >= 0);
+
+    writer_init(writer, WRITER_FD, WRITER_BUFFER_SIZE);
+    writer->fd = fd;
+
+    return writer->error;
+}
+
+// Initialize a writer to memory
+void writer_initMemory(tWriter * writer) {
+    // Verify pre conditions
+    assert(writer != NULL);
+
+    // No memory is allocated until something is written
+    writer_init(writer, WRITER_MEMORY, 0);
+}
+
+// Write a block of chars to the FILE* or file descriptor of a writer
+static void writer_writeRaw(tWriter * writer, const char * data, unsigned int length) {
+    ssize_t result;
+
+    if (writer->target == WRITER_FILE) {
+        if (length > 0 && fwrite(data, sizeof(char), length, writer->file) != length) {
+            writer->error = ERR_INVALID;
+        }
+        return;
+    }
+
+    // write can write only a part of the text
+    while (length > 0 && writer->error == OK) {
+        result = write(writer->fd, data, length);
+        if (result < 0) {
+            writer->error = ERR_INVALID;
+        }
+        else {
+            data += result;
+            length -= (unsigned int)result;
+        }
+    }
+}
+
+// Write the buffer of a FILE* or file descriptor writer
+static tError writer_output(tWriter * writer) {
+    if (writer->error == OK) {
+        writer_writeRaw(writer, writer->buffer, writer->size);
+    }
+    writer->size = 0;
+
+    return writer->error;
+}
+
+// Make room for length more chars in the buffer. Returns false if there is no room
+static bool writer_reserve(tWriter * writer, unsigned int length) {
+    if (writer->error != OK) {
+        return false;
+    }
+    if (writer->size + length <= writer->capacity) {
+        return true;
+    }
+
+    if (writer->target != WRITER_MEMORY) {
+        // Empty the buffer. Texts bigger than the buffer are written directly by writer_putString
+        return writer_output(writer) == OK && length <= writer->capacity;
+    }
+
+    // The memory grows with room for the final '\0'
+    writer->error = array_reserve(&writer->buffer, &writer->capacity, writer->size + length + 1, sizeof(char), WRITER_MIN_CAPACITY);
+
+    return writer->error == OK;
+}
+
+// Add a block of chars
+static void writer_putBlock(tWriter * writer, const char * data, unsigned int length) {
+    // Verify pre conditions
+    assert(writer != NULL);
+
+    if (writer->target != WRITER_MEMORY && length > writer->capacity) {
+        // The block does not fit in the buffer. Write the buffer and then the block, without copying it
+        if (writer_output(writer) == OK) {
+            writer_writeRaw(writer, data, length);
+        }
+        return;
+    }
+
+    if (writer_reserve(writer, length)) {
+        memcpy(writer->buffer + writer->size, data, length);
+        writer->size += length;
+    }
+}
+
+// Add a string
+void writer_putString(tWriter * writer, const char * str) {
+    // Verify pre conditions
+    assert(str != NULL);
+
+    writer_putBlock(writer, str, (unsigned int)strlen(str));
+}
+
+// Add a char
+void writer_putChar(tWriter * writer, char c) {
+    // Verify pre conditions
+    assert(writer != NULL);
+
+    if (writer_reserve(writer, 1)) {
+        writer->buffer[writer->size++] = c;
+    }
+}
+
+// Add an unsigned integer in base 10
+void writer_putULong(tWriter * writer, unsigned long value) {
+    // Enough room for the digits of the biggest unsigned long of 64 bits
+    char digits[20];
+    unsigned int pos = sizeof(digits);
+    unsigned int pair;
+
+    // Verify pre conditions
+    assert(writer != NULL);
+
+    // The digits are generated from the last one, two at a time
+    while (value >= 100) {
+        pair = (unsigned int)(value % 100) * 2;
+        value /= 100;
+        digits[--pos] = writer_digits[pair + 1];
+        digits[--pos] = writer_digits[pair];
+    }
+    if (value >= 10) {
+        pair = (unsigned int)value * 2;
+        digits[--pos] = writer_digits[pair + 1];
+        digits[--pos] = writer_digits[pair];
+    }
+    else {
+        digits[--pos] = (char)('0' + value);
+    }
+
+    writer_putBlock(writer, digits + pos, sizeof(digits) - pos);
+}
+
+// Add an integer in base 10
+void writer_putLong(tWriter * writer, long value) {
+    // Verify pre conditions
+    assert(writer != NULL);
+
+    if (value < 0) {
+        writer_putChar(writer, '-');
+        // Computed as unsigned, so the smallest long does not overflow
+        writer_putULong(writer, 0ul - (unsigned long)value);
+    }
+    else {
+        writer_putULong(writer, (unsigned long)value);
+    }
+}
+
+// Write the text in the buffer to the file
+tError writer_flush(tWriter * writer) {
+    // Verify pre conditions
+    assert(writer != NULL);
+
+    if (writer->target != WRITER_MEMORY && writer->error == OK) {
+        writer_output(writer);
+        if (writer->target == WRITER_FILE && writer->error == OK && fflush(writer->file) != 0) {
+            writer->error = ERR_INVALID;
+        }
+    }
+
+    return writer->error;
+}
+
+// Get the text of a memory writer, ended with '\0'
+const char * writer_data(tWriter * writer) {
+    // Verify pre conditions
+    assert(writer != NULL);
+    assert(writer->target == WRITER_MEMORY);
+
+    if (writer->buffer == NULL) {
+        return "";
+    }
+    // There is always room for the '\0' after the text
+    writer->buffer[writer->size] = '\0';
+
+    return writer->buffer;
+}
+
+// Get the first error found by the writer
+tError writer_error(tWriter * writer) {
+    // Verify pre conditions
+    assert(writer != NULL);
+
+    return writer->error;
+}
+
+// Write the pending text and remove the memory used by the writer
+tError writer_free(tWriter * writer) {
+    tError err;
+
+    // Verify pre conditions
+    assert(writer != NULL);
+
+    err = writer_flush(writer);
+    free(writer->buffer);
+    writer->buffer = NULL;
+    writer->size = 0;
+    writer->capacity = 0;
+
+    return err;
+}